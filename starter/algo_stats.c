@@ -0,0 +1,57 @@
+/*
+ * The instrumentation of our graph algorithms.
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include "algo_stats.h"
+
+#if GRAPH_STATS
+_Thread_local AlgoStats* activeStats = NULL;
+#endif
+
+void startStats(AlgoStats* stats)
+{
+  memset (stats, 0, sizeof (AlgoStats));
+#if GRAPH_STATS
+  activeStats = stats;
+#endif
+}
+
+AlgoStats* stopStats(void)
+{
+#if GRAPH_STATS
+  AlgoStats *stats = activeStats;
+  activeStats = NULL;
+  return stats;
+#else
+  return NULL;
+#endif
+}
+
+double statsNow(void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void printAlgoStats(AlgoStats* stats)
+{
+  if (!GRAPH_STATS)
+  {
+    printf ("Statistics are disabled; build with STATS=1.\n");
+    return;
+  }
+  printf ("heap inserts:          %lld\n", stats->heapInserts);
+  printf ("extractMins:           %lld\n", stats->extractMins);
+  printf ("decreasePriority:      %lld succeeded, %lld failed\n",
+          stats->decreaseSucceeded, stats->decreaseFailed);
+  printf ("sift levels:           %lld (deepest %lld)\n", stats->siftLevels,
+          stats->maxSiftDepth);
+  printf ("edges scanned:         %lld\n", stats->edgesScanned);
+  printf ("relaxations:           %lld\n", stats->relaxations);
+  printf ("init / loop / tree:    %.6f / %.6f / %.6f s\n", stats->initSeconds,
+          stats->loopSeconds, stats->treeSeconds);
+}
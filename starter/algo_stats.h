@@ -0,0 +1,96 @@
+/*
+ * Header file for the instrumentation of our graph algorithms.
+ *
+ * When built with -DGRAPH_STATS=1 (make STATS=1), the MinHeap and the
+ * Prim and Dijkstra runs of graph_algos.c count their work and time their
+ * phases into the AlgoStats that the calling thread activated with
+ * startStats. Otherwise every STATS_ macro expands to nothing, so the
+ * instrumentation costs nothing, and the counters of an activated
+ * AlgoStats stay 0.
+ *
+ *   AlgoStats stats;
+ *   startStats (&stats);
+ *   Edge *tree = getDistanceTreeDijkstra (graph, 0);
+ *   stopStats ();
+ *   printAlgoStats (&stats);
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef __Algo_Stats_header
+#define __Algo_Stats_header
+
+#ifndef GRAPH_STATS
+#define GRAPH_STATS 0
+#endif
+
+typedef struct algo_stats {
+  long long heapInserts;        // successful MinHeap inserts
+  long long extractMins;
+  long long decreaseSucceeded;  // decreasePriority calls that lowered a
+                                //   priority
+  long long decreaseFailed;     // decreasePriority calls that did not,
+                                //   and relaxations getMSTprim and
+                                //   getDistanceTreeDijkstra skip because
+                                //   getPriority shows they would not
+  long long siftLevels;         // levels moved by floatUp and heapify
+  long long maxSiftDepth;       // most levels moved by one sift
+  long long edgesScanned;       // edges looked at by the algorithm
+  long long relaxations;        // edges that improved a tentative value
+  double initSeconds;           // setting up the records and the heap
+  double loopSeconds;           // the main loop
+  double treeSeconds;           // building the resulting tree
+} AlgoStats;
+
+#if GRAPH_STATS
+
+// the AlgoStats of the calling thread, or NULL if none is active
+extern _Thread_local AlgoStats* activeStats;
+
+#define STATS_ADD(field, amount) \
+  do { if (activeStats) activeStats->field += (amount); } while (0)
+#define STATS_SIFT(levels) \
+  do { if (activeStats) { activeStats->siftLevels += (levels); \
+    if ((levels) > activeStats->maxSiftDepth) \
+      activeStats->maxSiftDepth = (levels); } } while (0)
+#define STATS_TIMER(name) double name = activeStats ? statsNow () : 0
+#define STATS_PHASE(field, timer) \
+  do { if (activeStats) { double now_ = statsNow (); \
+    activeStats->field += now_ - (timer); (timer) = now_; } } while (0)
+#define STATS_VAR(declaration) declaration
+
+#else
+
+#define STATS_ADD(field, amount) ((void) 0)
+#define STATS_SIFT(levels) ((void) 0)
+#define STATS_TIMER(name)
+#define STATS_PHASE(field, timer) ((void) 0)
+#define STATS_VAR(declaration)
+
+#endif
+
+/*
+ * Zeroes 'stats' and makes it the AlgoStats of the calling thread, so that
+ * the algorithms it runs next add to it.
+ */
+void startStats(AlgoStats* stats);
+
+/*
+ * Stops the calling thread from counting into its AlgoStats, and returns
+ * it, or NULL if it had none.
+ */
+AlgoStats* stopStats(void);
+
+/*
+ * Returns the current time in seconds from a monotonic clock.
+ */
+double statsNow(void);
+
+/*
+ * Prints all counters and timers of 'stats', one per line.
+ */
+void printAlgoStats(AlgoStats* stats);
+
+#endif
@@ -0,0 +1,159 @@
+/*
+ * Our ALT preprocessing and goal-directed search.
+ */
+
+#include <limits.h>
+
+#include "algo_stats.h"
+#include "alt.h"
+#include "graph_algos.h"
+
+/*
+ * Stores the distances of distance tree 'tree' as column 'column' of the
+ * vertex-major table 'table' with 'k' columns.
+ */
+static void storeColumn(dist_t* table, int k, int column, Edge* tree,
+                        int numVertices)
+{
+  for (int v = 0; v < numVertices; v++)
+    table[(size_t) v * k + column] = tree[v].weight;
+}
+
+Landmarks* newLandmarks(Graph* graph, Graph* reverse, int numLandmarks)
+{
+  int n = graph->numVertices;
+  if (numLandmarks < 1 || n == 0)
+    return NULL;
+  if (numLandmarks > n)
+    numLandmarks = n;
+
+  double start = statsNow ();
+  int k = numLandmarks;
+  Landmarks *lm = (Landmarks *) malloc (sizeof (Landmarks));
+  lm->numVertices = n;
+  lm->numLandmarks = k;
+  lm->ids = (int *) malloc (k * sizeof (int));
+  lm->fromLandmark = (dist_t *) malloc ((size_t) n * k * sizeof (dist_t));
+  lm->toLandmark = reverse
+                   ? (dist_t *) malloc ((size_t) n * k * sizeof (dist_t))
+                   : lm->fromLandmark;
+
+  /* minDist[v] is the distance from v's nearest landmark so far; the next
+   * landmark is the vertex farthest from all chosen ones. The first one is
+   * the vertex farthest from vertex 0. */
+  dist_t *minDist = (dist_t *) malloc (n * sizeof (dist_t));
+  Edge *tree = getDistanceTreeDijkstra (graph, 0);
+  for (int v = 0; v < n; v++)
+    minDist[v] = tree[v].weight;
+  free (tree);
+
+  for (int i = 0; i < k; i++)
+  {
+    int farthest = 0;
+    for (int v = 1; v < n; v++)
+      if (minDist[v] > minDist[farthest])
+        farthest = v;
+    lm->ids[i] = farthest;
+
+    tree = getDistanceTreeDijkstra (graph, farthest);
+    storeColumn (lm->fromLandmark, k, i, tree, n);
+    for (int v = 0; v < n; v++)
+      if (i == 0 || tree[v].weight < minDist[v])
+        minDist[v] = tree[v].weight;
+    free (tree);
+
+    if (reverse)
+    {
+      tree = getDistanceTreeDijkstra (reverse, farthest);
+      storeColumn (lm->toLandmark, k, i, tree, n);
+      free (tree);
+    }
+  }
+  free (minDist);
+
+  lm->preprocessSeconds = statsNow () - start;
+  return lm;
+}
+
+size_t landmarksBytes(Landmarks* lm)
+{
+  size_t table = (size_t) lm->numVertices * lm->numLandmarks
+                 * sizeof (dist_t);
+  return sizeof (Landmarks) + lm->numLandmarks * sizeof (int)
+         + (lm->toLandmark != lm->fromLandmark ? 2 * table : table);
+}
+
+dist_t landmarkLowerBound(Landmarks* lm, int vertex, int target)
+{
+  size_t k = lm->numLandmarks;
+  const dist_t *fromV = &lm->fromLandmark[vertex * k];
+  const dist_t *fromT = &lm->fromLandmark[target * k];
+  const dist_t *toV = &lm->toLandmark[vertex * k];
+  const dist_t *toT = &lm->toLandmark[target * k];
+
+  /* All entries are in [0, DIST_MAX], so the differences cannot overflow. */
+  dist_t bound = 0;
+  for (size_t i = 0; i < k; i++)
+  {
+    dist_t forward = fromT[i] - fromV[i];   // dist(L, t) - dist(L, v)
+    dist_t backward = toV[i] - toT[i];      // dist(v, L) - dist(t, L)
+    if (forward > bound)
+      bound = forward;
+    if (backward > bound)
+      bound = backward;
+  }
+  return bound;
+}
+
+dist_t getShortestPathALT(Landmarks* lm, Workspace* ws, Graph* graph,
+                          int source, int target, EdgeList** path)
+{
+  if (path)
+    *path = NULL;
+  if (source < 0 || source >= graph->numVertices || target < 0
+      || target >= graph->numVertices || ws->numVertices != graph->numVertices
+      || lm->numVertices != graph->numVertices)
+    return NOTHING;
+
+  resetWorkspace (ws);
+  wsRelaxWithKey (ws, source, 0, landmarkLowerBound (lm, source, target),
+                  NOTHING);
+
+  while (ws->heap->size > 0)
+  {
+    HeapNode u = wsSettleNext (ws);
+    if (u.id == target)
+      break;
+
+    dist_t du = ws->distances[u.id];
+    for (EdgeList *l = graph->vertices[u.id]->adjList; l != NULL; l = l->next)
+    {
+      int v = l->edge->toVertex;
+      if (wsSettled (ws, v))
+        continue;
+      /* The heuristic of v is fixed; reuse it once v is queued. */
+      dist_t h = wsReached (ws, v)
+                 ? getPriority (ws->heap, v) - ws->distances[v]
+                 : landmarkLowerBound (lm, v, target);
+      dist_t new_dist = distAdd (du, l->edge->weight);
+      wsRelaxWithKey (ws, v, new_dist, distAdd (new_dist, h), u.id);
+    }
+  }
+
+  if (!wsSettled (ws, target))
+    return NOTHING;
+  if (path)
+    *path = wsPathTo (ws, target);
+  return ws->distances[target];
+}
+
+void deleteLandmarks(Landmarks* lm)
+{
+  if (lm == NULL)
+    return;
+  if (lm->toLandmark != lm->fromLandmark)
+    free (lm->toLandmark);
+  free (lm->fromLandmark);
+  free (lm->ids);
+  free (lm);
+}
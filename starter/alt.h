@@ -0,0 +1,69 @@
+/*
+ * Header file for our ALT (A*, landmarks, triangle inequality) search.
+ *
+ * Preprocessing picks k landmark vertices and stores the distances from and
+ * to every landmark for every vertex. For any vertices v and t and landmark
+ * L, the triangle inequality gives the lower bounds
+ *   dist(v, t) >= dist(L, t) - dist(L, v)   and
+ *   dist(v, t) >= dist(v, L) - dist(t, L),
+ * whose maximum over all landmarks is a consistent A* heuristic.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "graph.h"
+#include "workspace.h"
+
+#ifndef __ALT_header
+#define __ALT_header
+
+typedef struct landmarks {
+  int numVertices;         // number of vertices of the preprocessed graph
+  int numLandmarks;        // number of landmarks, k
+  int* ids;                // ids[i] is the vertex ID of landmark i
+  dist_t* fromLandmark;    // fromLandmark[v*k + i] is dist(landmark i, v)
+  dist_t* toLandmark;      // toLandmark[v*k + i] is dist(v, landmark i);
+                           //   same array as fromLandmark if undirected
+  double preprocessSeconds;  // time newLandmarks took
+} Landmarks;
+
+/*
+ * Selects 'numLandmarks' landmarks in Graph 'graph' by farthest-point
+ * selection, computes their distances with getDistanceTreeDijkstra, and
+ * returns them. 'reverse' is the reverse of 'graph' (see newReverseGraph),
+ * or NULL if 'graph' is undirected. Distances of each vertex to all
+ * landmarks are stored next to each other, so one query looks up one
+ * contiguous block per vertex.
+ * Returns NULL if numLandmarks < 1 or 'graph' has no vertices.
+ * Precondition: 'graph' is (strongly) connected.
+ */
+Landmarks* newLandmarks(Graph* graph, Graph* reverse, int numLandmarks);
+
+/*
+ * Returns the number of bytes of memory used by 'lm'.
+ */
+size_t landmarksBytes(Landmarks* lm);
+
+/*
+ * Returns the ALT lower bound on dist(vertex, target). Distances stored as
+ * DIST_MAX (unreachable, or saturated by distAdd) keep the bound admissible.
+ */
+dist_t landmarkLowerBound(Landmarks* lm, int vertex, int target);
+
+/*
+ * Same as getShortestPathDijkstra, but runs A* search guided by the
+ * landmark lower bounds in 'lm', so fewer vertices are settled.
+ * Precondition: 'lm' was computed for 'graph'
+ */
+dist_t getShortestPathALT(Landmarks* lm, Workspace* ws, Graph* graph,
+                          int source, int target, EdgeList** path);
+
+/*
+ * Frees all memory allocated for 'lm'.
+ */
+void deleteLandmarks(Landmarks* lm);
+
+#endif
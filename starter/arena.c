@@ -0,0 +1,87 @@
+/*
+ * Our arena (slab) allocator.
+ */
+
+#include "arena.h"
+
+/*
+ * Rounds the slab header size up so that the usable bytes of a slab start at
+ * the strictest fundamental alignment.
+ */
+#define SLAB_HEADER_SIZE \
+  ((sizeof (Slab) + _Alignof (max_align_t) - 1) & ~(_Alignof (max_align_t) - 1))
+
+/*
+ * Returns the first usable byte of 'slab'.
+ */
+static char* slabData(Slab* slab)
+{
+  return (char *) slab + SLAB_HEADER_SIZE;
+}
+
+/*
+ * Creates a slab with 'size' usable bytes and pushes it onto 'arena'.
+ * Returns the new slab, or NULL if it could not be allocated.
+ */
+static Slab* pushSlab(Arena* arena, size_t size)
+{
+  Slab *slab = (Slab *) malloc (SLAB_HEADER_SIZE + size);
+  if (slab == NULL)
+    return NULL;
+  slab->size = size;
+  slab->used = 0;
+  slab->next = arena->current;
+  arena->current = slab;
+  arena->numSlabs++;
+  return slab;
+}
+
+Arena* newArena(size_t slabSize)
+{
+  Arena *arena = (Arena *) malloc (sizeof (Arena));
+  arena->current = NULL;
+  arena->slabSize = slabSize ? slabSize : ARENA_DEFAULT_SLAB_SIZE;
+  arena->numSlabs = 0;
+  return arena;
+}
+
+void* arenaAlloc(Arena* arena, size_t size, size_t align)
+{
+  Slab *slab = arena->current;
+  if (slab != NULL)
+  {
+    size_t start = (slab->used + align - 1) & ~(align - 1);
+    if (start + size <= slab->size)
+    {
+      slab->used = start + size;
+      return slabData (slab) + start;
+    }
+  }
+
+  /* Start a new slab; oversized requests get a slab to themselves. */
+  size_t slabSize = arena->slabSize;
+  if (size + align > slabSize)
+    slabSize = size + align;
+  slab = pushSlab (arena, slabSize);
+  if (slab == NULL)
+    return NULL;
+
+  size_t start = ((size_t) slabData (slab) + align - 1) & ~(align - 1);
+  start -= (size_t) slabData (slab);
+  slab->used = start + size;
+  return slabData (slab) + start;
+}
+
+void deleteArena(Arena* arena)
+{
+  if (arena == NULL)
+    return;
+  Slab *slab = arena->current;
+  while (slab)
+  {
+    Slab *nxt = slab->next;
+    free (slab);
+    slab = nxt;
+  }
+  free (arena);
+}
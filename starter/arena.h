@@ -0,0 +1,51 @@
+/*
+ * Header file for our arena (slab) allocator.
+ *
+ * An Arena hands out memory from large contiguous slabs by bumping a
+ * pointer. Individual allocations are never freed; the whole arena is
+ * released at once by deleteArena, in O(number of slabs).
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef __Arena_header
+#define __Arena_header
+
+#define ARENA_DEFAULT_SLAB_SIZE (1 << 20)
+
+typedef struct slab {
+  struct slab* next;  // the previously filled slab, or NULL
+  size_t size;        // number of usable bytes in this slab
+  size_t used;        // number of bytes handed out from this slab
+} Slab;               // the usable bytes follow the header
+
+typedef struct arena {
+  Slab* current;      // slab allocations are currently served from
+  size_t slabSize;    // usable size of each newly created slab
+  int numSlabs;       // total number of slabs owned by this arena
+} Arena;
+
+/*
+ * Returns a newly created empty Arena whose slabs hold 'slabSize' bytes
+ * each. A 'slabSize' of 0 selects ARENA_DEFAULT_SLAB_SIZE.
+ */
+Arena* newArena(size_t slabSize);
+
+/*
+ * Returns a pointer to 'size' bytes from 'arena' aligned to 'align' bytes,
+ * or NULL if memory could not be allocated. Requests that do not fit in a
+ * slab get a slab of their own.
+ * Precondition: 'align' is a power of two
+ */
+void* arenaAlloc(Arena* arena, size_t size, size_t align);
+
+/*
+ * Frees all memory allocated for 'arena', including every allocation that
+ * was served from it.
+ */
+void deleteArena(Arena* arena);
+
+#endif
@@ -0,0 +1,233 @@
+/*
+ * Our parallel Borůvka implementation.
+ *
+ * Edges are compared by the key (weight << 32 | index), a strict total
+ * order, so the edges picked in one round form a forest apart from both
+ * endpoints' components picking the same edge; the union-find rejects that
+ * duplicate.
+ */
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "boruvka.h"
+#include "thread_team.h"
+
+#define NO_EDGE UINT64_MAX
+
+typedef struct undirected_edge {
+  int u;
+  int v;
+  int weight;
+} UEdge;
+
+typedef struct boruvka_state {
+  int numVertices;
+  UEdge* edges;              // live edges of this round
+  UEdge* spare;              // compaction target for the next round
+  int numEdges;              // number of live edges
+  int* liveCount;            // liveCount[t] is the number of edges thread t
+                             //   keeps for the next round
+  _Atomic int* parent;       // concurrent union-find forest
+  _Atomic uint64_t* best;    // best[root] is the key of the lightest edge
+                             //   leaving component root, or NO_EDGE
+  Edge* forest;              // the resulting forest
+  _Atomic int numForestEdges;
+} BoruvkaState;
+
+/*
+ * Returns the root of the component of 'x', halving paths as it goes.
+ */
+static int findRoot(_Atomic int* parent, int x)
+{
+  int p = atomic_load_explicit (&parent[x], memory_order_relaxed);
+  while (p != x)
+  {
+    int gp = atomic_load_explicit (&parent[p], memory_order_relaxed);
+    atomic_compare_exchange_weak (&parent[x], &p, gp);
+    x = p;
+    p = atomic_load_explicit (&parent[x], memory_order_relaxed);
+  }
+  return x;
+}
+
+/*
+ * Joins the components of 'a' and 'b'. Returns true iff they were different.
+ */
+static bool unite(_Atomic int* parent, int a, int b)
+{
+  while (true)
+  {
+    a = findRoot (parent, a);
+    b = findRoot (parent, b);
+    if (a == b)
+      return false;
+    if (a < b)
+    {
+      int tmp = a;
+      a = b;
+      b = tmp;
+    }
+    /* Link the larger root under the smaller one; retry if a moved. */
+    int expected = a;
+    if (atomic_compare_exchange_strong (&parent[a], &expected, b))
+      return true;
+  }
+}
+
+/*
+ * Lowers 'slot' to 'key' if 'key' is smaller.
+ */
+static void atomicMin(_Atomic uint64_t* slot, uint64_t key)
+{
+  uint64_t old = atomic_load_explicit (slot, memory_order_relaxed);
+  while (key < old && !atomic_compare_exchange_weak (slot, &old, key))
+    ;
+}
+
+/*
+ * Team task: offers every edge of this thread's share that still joins two
+ * components to both components.
+ */
+static void pickTask(void* arg, int thread, int numThreads)
+{
+  BoruvkaState *st = (BoruvkaState *) arg;
+  int begin, end;
+  teamSlice (st->numEdges, thread, numThreads, &begin, &end);
+  for (int i = begin; i < end; i++)
+  {
+    int cu = findRoot (st->parent, st->edges[i].u);
+    int cv = findRoot (st->parent, st->edges[i].v);
+    if (cu == cv)
+      continue;
+    uint64_t key = (uint64_t) st->edges[i].weight << 32 | (uint32_t) i;
+    atomicMin (&st->best[cu], key);
+    atomicMin (&st->best[cv], key);
+  }
+}
+
+/*
+ * Team task: adds the lightest edge of every component in this thread's
+ * share of vertices to the forest.
+ */
+static void hookTask(void* arg, int thread, int numThreads)
+{
+  BoruvkaState *st = (BoruvkaState *) arg;
+  int begin, end;
+  teamSlice (st->numVertices, thread, numThreads, &begin, &end);
+  for (int r = begin; r < end; r++)
+  {
+    uint64_t key = atomic_load_explicit (&st->best[r], memory_order_relaxed);
+    if (key == NO_EDGE)
+      continue;
+    atomic_store_explicit (&st->best[r], NO_EDGE, memory_order_relaxed);
+
+    UEdge *e = &st->edges[(uint32_t) key];
+    if (unite (st->parent, e->u, e->v))
+    {
+      Edge edge = {e->u, e->v, e->weight};
+      st->forest[atomic_fetch_add (&st->numForestEdges, 1)] = edge;
+    }
+  }
+}
+
+/*
+ * Team task: counts the edges of this thread's share that still join two
+ * components.
+ */
+static void countTask(void* arg, int thread, int numThreads)
+{
+  BoruvkaState *st = (BoruvkaState *) arg;
+  int begin, end, live = 0;
+  teamSlice (st->numEdges, thread, numThreads, &begin, &end);
+  for (int i = begin; i < end; i++)
+    if (findRoot (st->parent, st->edges[i].u)
+        != findRoot (st->parent, st->edges[i].v))
+      live++;
+  st->liveCount[thread] = live;
+}
+
+/*
+ * Team task: copies the edges of this thread's share that still join two
+ * components to 'spare', at this thread's offset.
+ */
+static void compactTask(void* arg, int thread, int numThreads)
+{
+  BoruvkaState *st = (BoruvkaState *) arg;
+  int begin, end, out = 0;
+  for (int t = 0; t < thread; t++)
+    out += st->liveCount[t];
+  teamSlice (st->numEdges, thread, numThreads, &begin, &end);
+  for (int i = begin; i < end; i++)
+    if (findRoot (st->parent, st->edges[i].u)
+        != findRoot (st->parent, st->edges[i].v))
+      st->spare[out++] = st->edges[i];
+}
+
+Edge* getMSFboruvkaCSR(CSRGraph* csr, int numThreads, int* numTreeEdges)
+{
+  int n = csr->numVertices;
+  ThreadTeam *team = newThreadTeam (numThreads);
+
+  BoruvkaState st;
+  st.numVertices = n;
+  st.edges = (UEdge *) malloc ((csr->numEdges + 1) * sizeof (UEdge));
+  st.spare = (UEdge *) malloc ((csr->numEdges + 1) * sizeof (UEdge));
+  st.liveCount = (int *) calloc (team->numThreads, sizeof (int));
+  st.parent = (_Atomic int *) malloc ((n + 1) * sizeof (int));
+  st.best = (_Atomic uint64_t *) malloc ((n + 1) * sizeof (uint64_t));
+  st.forest = (Edge *) malloc ((n + 1) * sizeof (Edge));
+  atomic_init (&st.numForestEdges, 0);
+
+  /* Keep one direction of every undirected edge. */
+  st.numEdges = 0;
+  for (int u = 0; u < n; u++)
+    for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+      if (u < csr->targets[e])
+      {
+        UEdge edge = {u, csr->targets[e], csr->weights[e]};
+        st.edges[st.numEdges++] = edge;
+      }
+  for (int v = 0; v < n; v++)
+  {
+    atomic_init (&st.parent[v], v);
+    atomic_init (&st.best[v], NO_EDGE);
+  }
+
+  while (st.numEdges > 0)
+  {
+    teamRun (team, pickTask, &st);
+    teamRun (team, hookTask, &st);
+    teamRun (team, countTask, &st);
+    teamRun (team, compactTask, &st);
+
+    int live = 0;
+    for (int t = 0; t < team->numThreads; t++)
+      live += st.liveCount[t];
+
+    UEdge *tmp = st.edges;
+    st.edges = st.spare;
+    st.spare = tmp;
+    st.numEdges = live;
+  }
+
+  *numTreeEdges = atomic_load (&st.numForestEdges);
+
+  free (st.edges);
+  free (st.spare);
+  free (st.liveCount);
+  free ((void *) st.parent);
+  free ((void *) st.best);
+  deleteThreadTeam (team);
+
+  return st.forest;
+}
+
+Edge* getMSFboruvka(Graph* graph, int numThreads, int* numTreeEdges)
+{
+  CSRGraph *csr = csrFromGraph (graph);
+  Edge *forest = getMSFboruvkaCSR (csr, numThreads, numTreeEdges);
+  deleteCSRGraph (csr);
+  return forest;
+}
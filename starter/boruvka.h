@@ -0,0 +1,38 @@
+/*
+ * Header file for our parallel Borůvka minimum spanning forest.
+ *
+ * Every round, each component picks its lightest outgoing edge (edges are
+ * scanned in parallel and the minimum is kept with an atomic min), then all
+ * picked edges are added at once through a concurrent union-find. Edges
+ * inside a component are filtered out before the next round. There are at
+ * most log2(numVertices) rounds.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "csr.h"
+#include "graph.h"
+
+#ifndef __Boruvka_header
+#define __Boruvka_header
+
+/*
+ * Runs Borůvka's algorithm on 'csr' on 'numThreads' threads and returns a
+ * minimum spanning forest: an array of Edges with the same shape and total
+ * weight as the result of getMSTprim on a connected graph. '*numTreeEdges'
+ * is set to the number of Edges in the array, which is numVertices minus
+ * the number of connected components. Edges are reported as
+ * (u -- v, weight) with u < v.
+ * Precondition: 'csr' is undirected, i.e. every edge (u -- v, w) is stored
+ *               in both directions, as in our input format.
+ */
+Edge* getMSFboruvkaCSR(CSRGraph* csr, int numThreads, int* numTreeEdges);
+
+/*
+ * Same as getMSFboruvkaCSR, on Graph 'graph'.
+ */
+Edge* getMSFboruvka(Graph* graph, int numThreads, int* numTreeEdges);
+
+#endif
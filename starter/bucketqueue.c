@@ -0,0 +1,173 @@
+/*
+ * Our monotone integer priority queues (Dial's buckets and radix heap).
+ */
+
+#include "bucketqueue.h"
+
+#define RADIX_BUCKETS 33
+
+/*
+ * Returns the bucket that a node with priority 'priority' belongs in, given
+ * the current lower bound queue->last.
+ */
+static int bucketIndex(BucketQueue* queue, int priority)
+{
+  if (queue->kind == BQ_DIAL)
+    return priority % queue->numBuckets;
+  if (priority == queue->last)
+    return 0;
+  return 32 - __builtin_clz ((unsigned) (priority ^ queue->last));
+}
+
+/*
+ * Prepends node 'id' to bucket 'bucket' of 'queue'.
+ */
+static void linkNode(BucketQueue* queue, int id, int bucket)
+{
+  int head = queue->heads[bucket];
+  queue->next[id] = head;
+  queue->prev[id] = NOTHING;
+  if (head != NOTHING)
+    queue->prev[head] = id;
+  queue->heads[bucket] = id;
+  queue->bucketOf[id] = bucket;
+}
+
+/*
+ * Removes node 'id' from its bucket in 'queue'.
+ * Precondition: 'id' is in 'queue'
+ */
+static void unlinkNode(BucketQueue* queue, int id)
+{
+  int nxt = queue->next[id];
+  int prv = queue->prev[id];
+  if (prv != NOTHING)
+    queue->next[prv] = nxt;
+  else
+    queue->heads[queue->bucketOf[id]] = nxt;
+  if (nxt != NOTHING)
+    queue->prev[nxt] = prv;
+  queue->bucketOf[id] = NOTHING;
+}
+
+/*
+ * Returns the first non-empty bucket of 'queue' after redistributing nodes
+ * so that it only holds nodes of minimum priority.
+ * Precondition: 'queue' is non-empty
+ */
+static int minBucket(BucketQueue* queue)
+{
+  if (queue->kind == BQ_DIAL)
+  {
+    /* All queued priorities lie in [last, last + numBuckets), so the first
+     * non-empty bucket from last's holds only minimum-priority nodes. */
+    int b = queue->last % queue->numBuckets;
+    while (queue->heads[b] == NOTHING)
+      b = (b + 1 == queue->numBuckets) ? 0 : b + 1;
+    return b;
+  }
+
+  if (queue->heads[0] != NOTHING)
+    return 0;
+
+  int b = 1;
+  while (queue->heads[b] == NOTHING)
+    b++;
+
+  /* Raise the lower bound to the minimum of bucket b; all of its nodes then
+   * move to strictly smaller buckets, the minima to bucket 0. */
+  int min = queue->priority[queue->heads[b]];
+  for (int id = queue->heads[b]; id != NOTHING; id = queue->next[id])
+    if (queue->priority[id] < min)
+      min = queue->priority[id];
+  queue->last = min;
+
+  int id = queue->heads[b];
+  queue->heads[b] = NOTHING;
+  while (id != NOTHING)
+  {
+    int nxt = queue->next[id];
+    linkNode (queue, id, bucketIndex (queue, queue->priority[id]));
+    id = nxt;
+  }
+  return 0;
+}
+
+bool bqInsert(BucketQueue* queue, int priority, int id)
+{
+  if (queue->size + 1 > queue->capacity || queue->bucketOf[id] != NOTHING)
+    return false;
+
+  queue->priority[id] = priority;
+  linkNode (queue, id, bucketIndex (queue, priority));
+  queue->size++;
+  return true;
+}
+
+HeapNode bqExtractMin(BucketQueue* queue)
+{
+  int b = minBucket (queue);
+  int id = queue->heads[b];
+  unlinkNode (queue, id);
+  queue->size--;
+
+  HeapNode min = {queue->priority[id], id};
+  queue->last = min.priority;
+  return min;
+}
+
+int bqGetPriority(BucketQueue* queue, int id)
+{
+  return queue->priority[id];
+}
+
+bool bqContains(BucketQueue* queue, int id)
+{
+  return 0 <= id && id < queue->capacity && queue->bucketOf[id] != NOTHING;
+}
+
+bool bqDecreasePriority(BucketQueue* queue, int id, int newPriority)
+{
+  if (!bqContains (queue, id) || queue->priority[id] <= newPriority)
+    return false;
+
+  unlinkNode (queue, id);
+  queue->priority[id] = newPriority;
+  linkNode (queue, id, bucketIndex (queue, newPriority));
+  return true;
+}
+
+/***** Memory management ***************************************************/
+
+BucketQueue* newBucketQueue(int kind, int capacity, int maxWeight)
+{
+  BucketQueue *queue = (BucketQueue *) malloc (sizeof (BucketQueue));
+  queue->kind = kind;
+  queue->size = 0;
+  queue->capacity = capacity;
+  queue->last = 0;
+  queue->numBuckets = (kind == BQ_DIAL) ? maxWeight + 1 : RADIX_BUCKETS;
+
+  queue->priority = (int *) malloc (capacity * sizeof (int));
+  queue->bucketOf = (int *) malloc (capacity * sizeof (int));
+  queue->next = (int *) malloc (capacity * sizeof (int));
+  queue->prev = (int *) malloc (capacity * sizeof (int));
+  queue->heads = (int *) malloc (queue->numBuckets * sizeof (int));
+
+  for (int id = 0; id < capacity; id++)
+    queue->bucketOf[id] = NOTHING;
+  for (int b = 0; b < queue->numBuckets; b++)
+    queue->heads[b] = NOTHING;
+
+  return queue;
+}
+
+void deleteBucketQueue(BucketQueue* queue)
+{
+  free (queue->priority);
+  free (queue->bucketOf);
+  free (queue->next);
+  free (queue->prev);
+  free (queue->heads);
+  free (queue);
+}
@@ -0,0 +1,94 @@
+/*
+ * Header file for our monotone integer priority queues.
+ *
+ * Dijkstra's algorithm with non-negative integer weights only ever extracts
+ * priorities in non-decreasing order, so a queue may assume that no priority
+ * smaller than the last extracted one is ever inserted. Two such queues are
+ * provided behind one interface:
+ *
+ *   BQ_DIAL   Dial's algorithm: maxWeight+1 circular buckets. Every
+ *             operation is O(1) plus an O(maxWeight) scan per extractMin in
+ *             the worst case; best for small maximum edge weights.
+ *   BQ_RADIX  A radix heap: 33 buckets by the highest bit in which a
+ *             priority differs from the last extracted one. Every node moves
+ *             down at most 32 buckets over its lifetime, for O(log C)
+ *             amortized cost without any bound on the weights.
+ *
+ * Both are indexed by node ID like MinHeap, so decreasePriority is O(1).
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "minheap.h"
+
+#ifndef __BucketQueue_header
+#define __BucketQueue_header
+
+#define BQ_DIAL 0
+#define BQ_RADIX 1
+
+typedef struct bucket_queue {
+  int kind;         // BQ_DIAL or BQ_RADIX
+  int size;         // the number of nodes in this queue
+  int capacity;     // IDs of nodes in this queue are 0 .. capacity-1
+  int* priority;    // priority[id] is the priority of node id, if queued
+  int* bucketOf;    // bucketOf[id] is the bucket of node id, or NOTHING if
+                    //   node id is not in this queue
+  int* next;        // next[id] is the node after id in its bucket, or NOTHING
+  int* prev;        // prev[id] is the node before id in its bucket, or NOTHING
+  int numBuckets;   // the number of buckets
+  int* heads;       // heads[b] is the first node in bucket b, or NOTHING
+  int last;         // priority of the last extracted node; lower bound for
+                    //   all priorities in this queue
+} BucketQueue;
+
+/*
+ * Inserts a new node with priority 'priority' and ID 'id' into 'queue'.
+ * Returns: true if insert was successful, false otherwise
+ * Precondition: 'id' is not in 'queue'
+ *               priority >= the priority of the last extracted node
+ *               (for BQ_DIAL, also at most that priority plus maxWeight)
+ */
+bool bqInsert(BucketQueue* queue, int priority, int id);
+
+/*
+ * Removes and returns the node with minimum priority in 'queue'.
+ * Precondition: 'queue' is non-empty
+ */
+HeapNode bqExtractMin(BucketQueue* queue);
+
+/*
+ * Returns priority of the node with ID 'id' in 'queue'.
+ * Precondition: 'id' is in 'queue'
+ */
+int bqGetPriority(BucketQueue* queue, int id);
+
+/*
+ * Returns true iff the node with ID 'id' is in 'queue'.
+ */
+bool bqContains(BucketQueue* queue, int id);
+
+/*
+ * Sets priority of node with ID 'id' in 'queue' to 'newPriority', if such a
+ * node exists in 'queue' and its priority is larger than 'newPriority', and
+ * returns True. Has no effect and returns False, otherwise.
+ * Precondition: newPriority >= the priority of the last extracted node
+ */
+bool bqDecreasePriority(BucketQueue* queue, int id, int newPriority);
+
+/*
+ * Returns a newly created empty queue of kind 'kind' (BQ_DIAL or BQ_RADIX)
+ * for node IDs 0 .. capacity-1. 'maxWeight' is the largest edge weight of
+ * the graph and is only used by BQ_DIAL.
+ * Precondition: capacity >= 0, maxWeight >= 0
+ */
+BucketQueue* newBucketQueue(int kind, int capacity, int maxWeight);
+
+/*
+ * Frees all memory allocated for 'queue'.
+ */
+void deleteBucketQueue(BucketQueue* queue);
+
+#endif
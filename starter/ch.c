@@ -0,0 +1,594 @@
+/*
+ * Our Contraction Hierarchies preprocessing, queries and file format.
+ */
+
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "algo_stats.h"
+#include "ch.h"
+#include "minheap.h"
+
+// vertices settled by one witness search before it gives up and keeps the
+// shortcut; a missed witness only costs a superfluous shortcut
+#define WITNESS_SETTLE_LIMIT 500
+
+// first bytes and format version of a saved hierarchy
+#define CH_FILE_MAGIC "GACH"
+#define CH_FILE_VERSION 2
+
+typedef struct arc_list {
+  int size;
+  int capacity;
+  CHArc* arcs;
+} ArcList;
+
+/*
+ * State of the contraction: the arcs between the vertices not contracted
+ * yet, and the arcs of the contracted vertices that go into the hierarchy.
+ */
+typedef struct ch_builder {
+  int numVertices;
+  ArcList* out;           // out[u]: arcs u -> target of the remaining graph
+  ArcList* in;            // in[x]: arcs target -> x of the remaining graph
+  ArcList* up;            // up[v]: arcs kept when v was contracted
+  ArcList* down;          // down[v]: reversed arcs kept when v was contracted
+  int* contractedNeighbours;
+  Workspace* ws;          // for witness searches
+  int numShortcuts;
+} CHBuilder;
+
+/*
+ * Appends the arc (target, weight, middle) to 'list'.
+ */
+static void pushArc(ArcList* list, int target, dist_t weight, int middle)
+{
+  if (list->size == list->capacity)
+  {
+    list->capacity = list->capacity ? 2 * list->capacity : 4;
+    list->arcs = (CHArc *) realloc (list->arcs,
+                                    list->capacity * sizeof (CHArc));
+  }
+  list->arcs[list->size++] = (CHArc) { target, middle, weight };
+}
+
+/*
+ * Returns the arc of 'list' that leads to 'target', or NULL if none does.
+ */
+static CHArc* findListArc(ArcList* list, int target)
+{
+  for (int i = 0; i < list->size; i++)
+    if (list->arcs[i].target == target)
+      return &list->arcs[i];
+  return NULL;
+}
+
+/*
+ * Removes the arc leading to 'target' from 'list', if there is one.
+ */
+static void removeListArc(ArcList* list, int target)
+{
+  CHArc *arc = findListArc (list, target);
+  if (arc)
+    *arc = list->arcs[--list->size];
+}
+
+/*
+ * Adds the arc u -> x with weight 'weight' bypassing 'middle' to the
+ * remaining graph of 'b'. Keeps at most one arc per pair of vertices: an
+ * existing arc u -> x is replaced only if 'weight' is smaller. Counts the
+ * arcs that become shortcuts in b->numShortcuts.
+ */
+static void addArc(CHBuilder* b, int u, int x, dist_t weight, int middle)
+{
+  CHArc *existing = findListArc (&b->out[u], x);
+  if (existing)
+  {
+    if (existing->weight <= weight)
+      return;
+    if (existing->middle == NOTHING && middle != NOTHING)
+      b->numShortcuts++;
+    existing->weight = weight;
+    existing->middle = middle;
+    CHArc *reversed = findListArc (&b->in[x], u);
+    reversed->weight = weight;
+    reversed->middle = middle;
+    return;
+  }
+  pushArc (&b->out[u], x, weight, middle);
+  pushArc (&b->in[x], u, weight, middle);
+  if (middle != NOTHING)
+    b->numShortcuts++;
+}
+
+/*
+ * Runs Dijkstra's algorithm from 'source' in the remaining graph of 'b'
+ * without vertex 'avoid', until all vertices within distance 'limit' or
+ * WITNESS_SETTLE_LIMIT vertices are settled. The distances are left in
+ * b->ws.
+ */
+static void witnessSearch(CHBuilder* b, int source, int avoid, dist_t limit)
+{
+  Workspace *ws = b->ws;
+  resetWorkspace (ws);
+  wsRelax (ws, source, 0, NOTHING);
+
+  for (int settled = 0; ws->heap->size > 0 && settled < WITNESS_SETTLE_LIMIT;
+       settled++)
+  {
+    if (getMin (ws->heap).priority > limit)
+      break;
+    HeapNode u = wsSettleNext (ws);
+    ArcList *out = &b->out[u.id];
+    for (int i = 0; i < out->size; i++)
+    {
+      int x = out->arcs[i].target;
+      if (x != avoid)
+        wsRelax (ws, x, distAdd (u.priority, out->arcs[i].weight), u.id);
+    }
+  }
+}
+
+/*
+ * Returns the number of shortcuts contracting vertex 'v' needs. Also adds
+ * them to the remaining graph of 'b', unless 'simulate' is true; some of
+ * them may then merge into lighter arcs that are already there.
+ */
+static int contractVertex(CHBuilder* b, int v, bool simulate)
+{
+  ArcList *in = &b->in[v];
+  ArcList *out = &b->out[v];
+  int shortcuts = 0;
+
+  for (int i = 0; i < in->size; i++)
+  {
+    int u = in->arcs[i].target;
+    dist_t toV = in->arcs[i].weight;
+
+    dist_t limit = -1;
+    for (int j = 0; j < out->size; j++)
+    {
+      int x = out->arcs[j].target;
+      if (x != u && distAdd (toV, out->arcs[j].weight) > limit)
+        limit = distAdd (toV, out->arcs[j].weight);
+    }
+    if (limit < 0)
+      continue;
+
+    /* u -> v -> x needs a shortcut unless a path avoiding v is as short. */
+    witnessSearch (b, u, v, limit);
+    for (int j = 0; j < out->size; j++)
+    {
+      int x = out->arcs[j].target;
+      dist_t via = distAdd (toV, out->arcs[j].weight);
+      if (x == u || wsDistance (b->ws, x) <= via)
+        continue;
+      shortcuts++;
+      if (!simulate)
+        addArc (b, u, x, via, v);
+    }
+  }
+  return shortcuts;
+}
+
+/*
+ * Returns the contraction priority of vertex 'v': its edge difference (the
+ * shortcuts contracting it adds minus the arcs it removes) plus the number
+ * of its neighbours already contracted, which spreads contraction evenly
+ * over the graph. Smaller is contracted first.
+ */
+static int contractionPriority(CHBuilder* b, int v)
+{
+  int removed = b->in[v].size + b->out[v].size;
+  return contractVertex (b, v, true) - removed + b->contractedNeighbours[v];
+}
+
+/*
+ * Contracts vertex 'v': adds its shortcuts, moves its remaining arcs into
+ * the hierarchy, and removes it from the remaining graph of 'b'.
+ */
+static void finishVertex(CHBuilder* b, int v)
+{
+  contractVertex (b, v, false);
+
+  ArcList *lists[2] = { &b->out[v], &b->in[v] };
+  ArcList *kept[2] = { &b->up[v], &b->down[v] };
+  ArcList *reversed[2] = { b->in, b->out };
+  for (int k = 0; k < 2; k++)
+  {
+    for (int i = 0; i < lists[k]->size; i++)
+    {
+      CHArc arc = lists[k]->arcs[i];
+      pushArc (kept[k], arc.target, arc.weight, arc.middle);
+      removeListArc (&reversed[k][arc.target], v);
+      b->contractedNeighbours[arc.target]++;
+    }
+    free (lists[k]->arcs);
+    lists[k]->arcs = NULL;
+    lists[k]->size = lists[k]->capacity = 0;
+  }
+}
+
+/*
+ * Packs the lists 'lists' of 'n' vertices into an offsets array (returned)
+ * and an arcs array ('*arcs').
+ */
+static int* packArcLists(ArcList* lists, int n, CHArc** arcs)
+{
+  int *offsets = (int *) malloc ((n + 1) * sizeof (int));
+  offsets[0] = 0;
+  for (int v = 0; v < n; v++)
+    offsets[v + 1] = offsets[v] + lists[v].size;
+
+  *arcs = (CHArc *) malloc ((offsets[n] > 0 ? offsets[n] : 1) * sizeof (CHArc));
+  for (int v = 0; v < n; v++)
+  {
+    if (lists[v].size > 0)
+      memcpy (&(*arcs)[offsets[v]], lists[v].arcs,
+              lists[v].size * sizeof (CHArc));
+    free (lists[v].arcs);
+  }
+  return offsets;
+}
+
+ContractionHierarchy* newContractionHierarchy(Graph* graph)
+{
+  double start = statsNow ();
+  int n = graph->numVertices;
+
+  CHBuilder b;
+  b.numVertices = n;
+  b.out = (ArcList *) calloc (n, sizeof (ArcList));
+  b.in = (ArcList *) calloc (n, sizeof (ArcList));
+  b.up = (ArcList *) calloc (n, sizeof (ArcList));
+  b.down = (ArcList *) calloc (n, sizeof (ArcList));
+  b.contractedNeighbours = (int *) calloc (n, sizeof (int));
+  b.ws = newWorkspace (n);
+  b.numShortcuts = 0;
+
+  for (int u = 0; u < n; u++)
+    for (EdgeList *l = graph->vertices[u]->adjList; l != NULL; l = l->next)
+      if (l->edge->toVertex != u)
+        addArc (&b, u, l->edge->toVertex, l->edge->weight, NOTHING);
+
+  ContractionHierarchy *ch = (ContractionHierarchy *)
+    malloc (sizeof (ContractionHierarchy));
+  ch->numVertices = n;
+  ch->rank = (int *) malloc (n * sizeof (int));
+
+  /* Lazy updates: a vertex whose priority went up since it was queued is
+   * queued again instead of contracted. */
+  MinHeap *order = newHeap (n);
+  for (int v = 0; v < n; v++)
+    insert (order, contractionPriority (&b, v), v);
+
+  int nextRank = 0;
+  while (order->size > 0)
+  {
+    int v = extractMin (order).id;
+    int priority = contractionPriority (&b, v);
+    if (order->size > 0 && priority > getMin (order).priority)
+    {
+      insert (order, priority, v);
+      continue;
+    }
+    finishVertex (&b, v);
+    ch->rank[v] = nextRank++;
+  }
+  deleteHeap (order);
+
+  ch->upOffsets = packArcLists (b.up, n, &ch->upArcs);
+  ch->downOffsets = packArcLists (b.down, n, &ch->downArcs);
+  ch->numShortcuts = b.numShortcuts;
+
+  free (b.out);
+  free (b.in);
+  free (b.up);
+  free (b.down);
+  free (b.contractedNeighbours);
+  deleteWorkspace (b.ws);
+
+  ch->preprocessSeconds = statsNow () - start;
+  return ch;
+}
+
+/*
+ * Returns the arc stored with vertex 'v' in 'offsets'/'arcs' that has
+ * target 'target', or NULL if there is none.
+ */
+static CHArc* findArc(int* offsets, CHArc* arcs, int v, int target)
+{
+  for (int i = offsets[v]; i < offsets[v + 1]; i++)
+    if (arcs[i].target == target)
+      return &arcs[i];
+  return NULL;
+}
+
+/*
+ * Appends the original edges that arc u -> x with weight 'weight' bypassing
+ * 'middle' stands for to the list ending at '*tail', and advances '*tail'.
+ */
+static void unpackArc(ContractionHierarchy* ch, int u, int x, dist_t weight,
+                      int middle, EdgeList*** tail)
+{
+  if (middle == NOTHING)
+  {
+    **tail = newEdgeList (newEdge (u, x, weight), NULL);
+    *tail = &(**tail)->next;
+    return;
+  }
+  /* middle was contracted before u and x, so u -> middle is a reversed arc
+   * of middle and middle -> x is an up arc of middle. */
+  CHArc *first = findArc (ch->downOffsets, ch->downArcs, middle, u);
+  CHArc *second = findArc (ch->upOffsets, ch->upArcs, middle, x);
+  unpackArc (ch, u, middle, first->weight, first->middle, tail);
+  unpackArc (ch, middle, x, second->weight, second->middle, tail);
+}
+
+/*
+ * Returns the shortest path from 'source' to 'target' through 'meet' found
+ * by the upward searches 'forward' and 'backward', unpacked into the
+ * original edges.
+ */
+static EdgeList* unpackPath(ContractionHierarchy* ch, Workspace* forward,
+                            Workspace* backward, int meet)
+{
+  EdgeList *path = NULL;
+  EdgeList **tail = &path;
+
+  /* The forward search tree is walked from 'meet' down to the source, so
+   * collect its vertices first and unpack them in path order. */
+  int numUp = 0;
+  for (int v = meet; forward->predecessors[v] != NOTHING;
+       v = forward->predecessors[v])
+    numUp++;
+  int *upPath = (int *) malloc ((numUp + 1) * sizeof (int));
+  int i = numUp;
+  for (int v = meet; ; v = forward->predecessors[v])
+  {
+    upPath[i--] = v;
+    if (forward->predecessors[v] == NOTHING)
+      break;
+  }
+  for (i = 0; i < numUp; i++)
+  {
+    CHArc *arc = findArc (ch->upOffsets, ch->upArcs, upPath[i], upPath[i + 1]);
+    unpackArc (ch, upPath[i], upPath[i + 1], arc->weight, arc->middle, &tail);
+  }
+  free (upPath);
+
+  for (int v = meet; backward->predecessors[v] != NOTHING;
+       v = backward->predecessors[v])
+  {
+    int next = backward->predecessors[v];
+    CHArc *arc = findArc (ch->downOffsets, ch->downArcs, next, v);
+    unpackArc (ch, v, next, arc->weight, arc->middle, &tail);
+  }
+  return path;
+}
+
+dist_t getShortestPathCH(ContractionHierarchy* ch, Workspace* forward,
+                         Workspace* backward, int source, int target,
+                         EdgeList** path)
+{
+  if (path)
+    *path = NULL;
+  int n = ch->numVertices;
+  if (source < 0 || source >= n || target < 0 || target >= n
+      || forward->numVertices != n || backward->numVertices != n)
+    return NOTHING;
+
+  resetWorkspace (forward);
+  resetWorkspace (backward);
+  wsRelax (forward, source, 0, NOTHING);
+  wsRelax (backward, target, 0, NOTHING);
+
+  Workspace *sides[2] = { forward, backward };
+  int *offsets[2] = { ch->upOffsets, ch->downOffsets };
+  CHArc *arcs[2] = { ch->upArcs, ch->downArcs };
+  dist_t best = DIST_MAX;
+  int meet = NOTHING;
+
+  /* Alternate between the searches by smallest key. A search stops once
+   * its smallest key reaches the best distance found so far. */
+  while (true)
+  {
+    int side = -1;
+    for (int k = 0; k < 2; k++)
+      if (sides[k]->heap->size > 0 && getMin (sides[k]->heap).priority < best
+          && (side < 0 || getMin (sides[k]->heap).priority
+                          < getMin (sides[side]->heap).priority))
+        side = k;
+    if (side < 0)
+      break;
+
+    Workspace *ws = sides[side];
+    Workspace *other = sides[1 - side];
+    HeapNode u = wsSettleNext (ws);
+    if (wsSettled (other, u.id)
+        && distAdd (u.priority, other->distances[u.id]) < best)
+    {
+      best = distAdd (u.priority, other->distances[u.id]);
+      meet = u.id;
+    }
+
+    for (int i = offsets[side][u.id]; i < offsets[side][u.id + 1]; i++)
+      wsRelax (ws, arcs[side][i].target,
+               distAdd (u.priority, arcs[side][i].weight), u.id);
+  }
+
+  if (meet == NOTHING)
+    return NOTHING;
+  if (path)
+    *path = unpackPath (ch, forward, backward, meet);
+  return best;
+}
+
+size_t chBytes(ContractionHierarchy* ch)
+{
+  size_t n = ch->numVertices;
+  size_t numArcs = ch->upOffsets[n] + ch->downOffsets[n];
+  return sizeof (ContractionHierarchy) + (3 * n + 2) * sizeof (int)
+         + numArcs * sizeof (CHArc);
+}
+
+/*
+ * Saved hierarchies start with this header, followed by rank, upOffsets,
+ * upArcs, downOffsets and downArcs in native byte order. Arc weights are
+ * dist_t, so a hierarchy only loads in a build with the same DIST_BITS.
+ */
+typedef struct ch_file_header {
+  char magic[4];
+  int32_t version;
+  int32_t weightBytes;   // sizeof (dist_t) of the build that saved it
+  int32_t numVertices;
+  int32_t numUpArcs;
+  int32_t numDownArcs;
+  int32_t numShortcuts;
+} CHFileHeader;
+
+bool saveContractionHierarchy(ContractionHierarchy* ch, const char* filename)
+{
+  FILE *file = fopen (filename, "wb");
+  if (file == NULL)
+    return false;
+
+  size_t n = ch->numVertices;
+  CHFileHeader header;
+  memcpy (header.magic, CH_FILE_MAGIC, 4);
+  header.version = CH_FILE_VERSION;
+  header.weightBytes = sizeof (dist_t);
+  header.numVertices = ch->numVertices;
+  header.numUpArcs = ch->upOffsets[n];
+  header.numDownArcs = ch->downOffsets[n];
+  header.numShortcuts = ch->numShortcuts;
+
+  bool ok = fwrite (&header, sizeof (header), 1, file) == 1
+    && fwrite (ch->rank, sizeof (int), n, file) == n
+    && fwrite (ch->upOffsets, sizeof (int), n + 1, file) == n + 1
+    && fwrite (ch->upArcs, sizeof (CHArc), header.numUpArcs, file)
+       == (size_t) header.numUpArcs
+    && fwrite (ch->downOffsets, sizeof (int), n + 1, file) == n + 1
+    && fwrite (ch->downArcs, sizeof (CHArc), header.numDownArcs, file)
+       == (size_t) header.numDownArcs;
+  return fclose (file) == 0 && ok;
+}
+
+/*
+ * Returns true iff 'offsets' is a valid offsets array of 'n' vertices into
+ * 'numArcs' arcs whose targets are all vertices and whose weights are not
+ * negative.
+ */
+static bool validArcs(int* offsets, CHArc* arcs, int n, int numArcs)
+{
+  if (offsets[0] != 0 || offsets[n] != numArcs)
+    return false;
+  for (int v = 0; v < n; v++)
+    if (offsets[v] > offsets[v + 1])
+      return false;
+  for (int i = 0; i < numArcs; i++)
+    if (arcs[i].target < 0 || arcs[i].target >= n || arcs[i].middle < NOTHING
+        || arcs[i].middle >= n || arcs[i].weight < 0)
+      return false;
+  return true;
+}
+
+/*
+ * Returns true iff every rank of 'ch' is a vertex position and every
+ * shortcut of 'ch' can be unpacked: the arcs u -> middle and middle -> x
+ * of a shortcut u -> x exist, and middle ranks below u and x, so
+ * unpacking ends.
+ * Precondition: the arcs of 'ch' pass validArcs
+ */
+static bool validShortcuts(ContractionHierarchy* ch)
+{
+  int n = ch->numVertices;
+  for (int v = 0; v < n; v++)
+    if (ch->rank[v] < 0 || ch->rank[v] >= n)
+      return false;
+
+  int *offsets[2] = { ch->upOffsets, ch->downOffsets };
+  CHArc *arcs[2] = { ch->upArcs, ch->downArcs };
+  for (int k = 0; k < 2; k++)
+    for (int v = 0; v < n; v++)
+      for (int i = offsets[k][v]; i < offsets[k][v + 1]; i++)
+      {
+        int middle = arcs[k][i].middle;
+        if (middle == NOTHING)
+          continue;
+        /* Up arcs are v -> target, down arcs target -> v. */
+        int u = k == 0 ? v : arcs[k][i].target;
+        int x = k == 0 ? arcs[k][i].target : v;
+        if (ch->rank[middle] >= ch->rank[u] || ch->rank[middle] >= ch->rank[x]
+            || findArc (ch->downOffsets, ch->downArcs, middle, u) == NULL
+            || findArc (ch->upOffsets, ch->upArcs, middle, x) == NULL)
+          return false;
+      }
+  return true;
+}
+
+ContractionHierarchy* loadContractionHierarchy(const char* filename)
+{
+  FILE *file = fopen (filename, "rb");
+  if (file == NULL)
+    return NULL;
+
+  CHFileHeader header;
+  if (fread (&header, sizeof (header), 1, file) != 1
+      || memcmp (header.magic, CH_FILE_MAGIC, 4) != 0
+      || header.version != CH_FILE_VERSION
+      || header.weightBytes != (int32_t) sizeof (dist_t)
+      || header.numVertices < 0
+      || header.numUpArcs < 0 || header.numDownArcs < 0)
+  {
+    fclose (file);
+    return NULL;
+  }
+
+  size_t n = header.numVertices;
+  ContractionHierarchy *ch = (ContractionHierarchy *)
+    malloc (sizeof (ContractionHierarchy));
+  ch->numVertices = header.numVertices;
+  ch->numShortcuts = header.numShortcuts;
+  ch->preprocessSeconds = 0;
+  ch->rank = (int *) malloc ((n > 0 ? n : 1) * sizeof (int));
+  ch->upOffsets = (int *) malloc ((n + 1) * sizeof (int));
+  ch->upArcs = (CHArc *) malloc ((header.numUpArcs > 0 ? header.numUpArcs : 1)
+                                 * sizeof (CHArc));
+  ch->downOffsets = (int *) malloc ((n + 1) * sizeof (int));
+  ch->downArcs = (CHArc *) malloc ((header.numDownArcs > 0
+                                    ? header.numDownArcs : 1)
+                                   * sizeof (CHArc));
+
+  bool ok = fread (ch->rank, sizeof (int), n, file) == n
+    && fread (ch->upOffsets, sizeof (int), n + 1, file) == n + 1
+    && fread (ch->upArcs, sizeof (CHArc), header.numUpArcs, file)
+       == (size_t) header.numUpArcs
+    && fread (ch->downOffsets, sizeof (int), n + 1, file) == n + 1
+    && fread (ch->downArcs, sizeof (CHArc), header.numDownArcs, file)
+       == (size_t) header.numDownArcs
+    && validArcs (ch->upOffsets, ch->upArcs, n, header.numUpArcs)
+    && validArcs (ch->downOffsets, ch->downArcs, n, header.numDownArcs)
+    && validShortcuts (ch);
+  fclose (file);
+
+  if (!ok)
+  {
+    deleteContractionHierarchy (ch);
+    return NULL;
+  }
+  return ch;
+}
+
+void deleteContractionHierarchy(ContractionHierarchy* ch)
+{
+  if (ch == NULL)
+    return;
+  free (ch->rank);
+  free (ch->upOffsets);
+  free (ch->upArcs);
+  free (ch->downOffsets);
+  free (ch->downArcs);
+  free (ch);
+}
@@ -0,0 +1,93 @@
+/*
+ * Header file for our Contraction Hierarchies (CH).
+ *
+ * Preprocessing contracts the vertices one by one in order of importance.
+ * Contracting v removes it and adds a shortcut u -> x (weight w(u, v) +
+ * w(v, x)) for every pair of remaining neighbours whose only shortest path
+ * runs through v. The rank of a vertex is its position in this order.
+ *
+ * Every shortest path then has an equivalent path that first climbs and
+ * then descends in rank, so a query only needs two small upward searches:
+ * forward from the source over arcs to higher ranks, and backward from the
+ * target over reversed arcs from higher ranks. Each shortcut remembers the
+ * vertex it bypasses, so paths can be unpacked into original edges.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "graph.h"
+#include "workspace.h"
+
+#ifndef __CH_header
+#define __CH_header
+
+typedef struct ch_arc {
+  int target;     // the other endpoint of this arc
+  int middle;     // vertex bypassed by this shortcut, or NOTHING if this
+                  //   arc is an edge of the original graph
+  dist_t weight;  // weight of this arc; shortcuts add up weights with
+                  //   distAdd, so they can be longer than any edge
+} CHArc;
+
+typedef struct contraction_hierarchy {
+  int numVertices;      // vertex IDs are 0, 1, ..., numVertices-1
+  int* rank;            // rank[v] is the position of v in contraction order
+  int* upOffsets;       // numVertices+1 entries; the up arcs of v are
+                        //   upArcs[upOffsets[v] .. upOffsets[v+1]-1]
+  CHArc* upArcs;        // arcs v -> target with rank[target] > rank[v]
+  int* downOffsets;     // numVertices+1 entries, like upOffsets
+  CHArc* downArcs;      // arcs target -> v with rank[target] > rank[v],
+                        //   stored with v, i.e. the reversed arcs
+  int numShortcuts;     // number of arcs that are shortcuts
+  double preprocessSeconds;  // time the contraction took; 0 if loaded
+} ContractionHierarchy;
+
+/*
+ * Orders and contracts all vertices of Graph 'graph' and returns the
+ * resulting hierarchy. 'graph' may be directed.
+ */
+ContractionHierarchy* newContractionHierarchy(Graph* graph);
+
+/*
+ * Returns distance(source, target) in the graph 'ch' was built from, or
+ * NOTHING if 'target' is unreachable or either vertex is not valid. If
+ * 'path' is not NULL, '*path' is set to the list of original edges of a
+ * shortest path
+ *   [(source -- id_1, w_1), (id_1 -- id_2, w_2), ..., (id_n -- target, w_n)]
+ * which is NULL if source == target or no path exists; the caller frees it
+ * with deleteEdgeList. Workspaces 'forward' and 'backward' hold the state of
+ * the two upward searches.
+ * The path uses the EdgeList format of getShortestPaths, but runs from
+ * 'source' to 'target' like getShortestPathDijkstra instead of back to the
+ * start: in a directed graph only this orientation consists of edges of
+ * the graph, and it can be checked against getShortestPathDijkstra.
+ */
+dist_t getShortestPathCH(ContractionHierarchy* ch, Workspace* forward,
+                         Workspace* backward, int source, int target,
+                         EdgeList** path);
+
+/*
+ * Returns the number of bytes of memory used by 'ch'.
+ */
+size_t chBytes(ContractionHierarchy* ch);
+
+/*
+ * Writes 'ch' to the file 'filename'. Returns true iff successful.
+ */
+bool saveContractionHierarchy(ContractionHierarchy* ch, const char* filename);
+
+/*
+ * Reads and returns a hierarchy written by saveContractionHierarchy from the
+ * file 'filename', or NULL if the file cannot be read or is not valid.
+ */
+ContractionHierarchy* loadContractionHierarchy(const char* filename);
+
+/*
+ * Frees all memory allocated for 'ch'.
+ */
+void deleteContractionHierarchy(ContractionHierarchy* ch);
+
+#endif
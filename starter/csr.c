@@ -0,0 +1,150 @@
+/*
+ * Our compressed sparse row (CSR) graph implementation.
+ */
+
+#include <string.h>
+
+#include "csr.h"
+
+/*********************************************************************
+ ** Displaying CSR graphs
+ *********************************************************************/
+
+void printCSRGraph(CSRGraph* csr)
+{
+  if (csr == NULL)
+  {
+    printf("NULL");
+    return;
+  }
+  printf("Number of vertices: %d. Number of edges: %d.\n\n", csr->numVertices,
+         csr->numEdges);
+
+  for (int v = 0; v < csr->numVertices; v++)
+  {
+    printf("%d: ", v);
+    for (int e = csr->offsets[v]; e < csr->offsets[v + 1]; e++)
+      printf("(%d -- %d, %d) --> ", v, csr->targets[e], csr->weights[e]);
+    printf("NULL\n");
+  }
+  printf("\n");
+}
+
+/*********************************************************************
+ ** Memory management
+ *********************************************************************/
+
+CSRGraph* newCSRGraph(int numVertices, int numEdges)
+{
+  CSRGraph *csr = (CSRGraph *) malloc (sizeof (CSRGraph));
+  csr->numVertices = numVertices;
+  csr->numEdges = numEdges;
+  csr->offsets = (int *) malloc ((numVertices + 1) * sizeof (int));
+  csr->targets = (int *) malloc (numEdges * sizeof (int));
+  csr->weights = (int *) malloc (numEdges * sizeof (int));
+  csr->offsets[0] = 0;
+  return csr;
+}
+
+CSRGraph* csrFromGraph(Graph* graph)
+{
+  if (graph == NULL)
+    return NULL;
+
+  /* Count the real number of edges rather than trusting graph->numEdges. */
+  int numEdges = 0;
+  for (int v = 0; v < graph->numVertices; v++)
+    for (EdgeList *l = graph->vertices[v]->adjList; l != NULL; l = l->next)
+      numEdges++;
+
+  CSRGraph *csr = newCSRGraph (graph->numVertices, numEdges);
+
+  int e = 0;
+  for (int v = 0; v < graph->numVertices; v++)
+  {
+    for (EdgeList *l = graph->vertices[v]->adjList; l != NULL; l = l->next)
+    {
+      csr->targets[e] = l->edge->toVertex;
+      csr->weights[e] = l->edge->weight;
+      e++;
+    }
+    csr->offsets[v + 1] = e;
+  }
+  return csr;
+}
+
+CSRGraph* csrFromEdges(int numVertices, int numEdges, Edge* edges)
+{
+  for (int i = 0; i < numEdges; i++)
+    if (edges[i].fromVertex < 0 || edges[i].fromVertex >= numVertices
+        || edges[i].toVertex < 0 || edges[i].toVertex >= numVertices)
+      return NULL;
+
+  CSRGraph *csr = newCSRGraph (numVertices, numEdges);
+
+  /* Counting sort on the "from" vertex: degrees, then prefix sums. */
+  for (int v = 0; v <= numVertices; v++)
+    csr->offsets[v] = 0;
+  for (int i = 0; i < numEdges; i++)
+    csr->offsets[edges[i].fromVertex + 1]++;
+  for (int v = 0; v < numVertices; v++)
+    csr->offsets[v + 1] += csr->offsets[v];
+
+  int *next = (int *) malloc ((numVertices + 1) * sizeof (int));
+  memcpy (next, csr->offsets, (numVertices + 1) * sizeof (int));
+  for (int i = 0; i < numEdges; i++)
+  {
+    int e = next[edges[i].fromVertex]++;
+    csr->targets[e] = edges[i].toVertex;
+    csr->weights[e] = edges[i].weight;
+  }
+  free (next);
+
+  return csr;
+}
+
+Graph* graphFromCSR(CSRGraph* csr)
+{
+  int n = csr->numVertices;
+  int m = csr->numEdges;
+
+  /* The arrays get slabs of their own, so the default slab size is fine. */
+  Graph *graph = newArenaGraph (n, 0);
+  Vertex *vertices = (Vertex *) arenaAlloc (graph->arena, n * sizeof (Vertex),
+                                            _Alignof (Vertex));
+  Edge *edges = (Edge *) arenaAlloc (graph->arena, m * sizeof (Edge),
+                                     _Alignof (Edge));
+  EdgeList *nodes = (EdgeList *) arenaAlloc (graph->arena,
+                                             m * sizeof (EdgeList),
+                                             _Alignof (EdgeList));
+
+  for (int v = 0; v < n; v++)
+  {
+    int begin = csr->offsets[v];
+    int end = csr->offsets[v + 1];
+    for (int e = begin; e < end; e++)
+    {
+      edges[e].fromVertex = v;
+      edges[e].toVertex = csr->targets[e];
+      edges[e].weight = csr->weights[e];
+      nodes[e].edge = &edges[e];
+      nodes[e].next = e + 1 < end ? &nodes[e + 1] : NULL;
+    }
+    vertices[v].id = v;
+    vertices[v].value = NULL;
+    vertices[v].adjList = begin < end ? &nodes[begin] : NULL;
+    graph->vertices[v] = &vertices[v];
+  }
+  graph->numEdges = m;
+  return graph;
+}
+
+void deleteCSRGraph(CSRGraph* csr)
+{
+  if (csr == NULL)
+    return;
+  free (csr->offsets);
+  free (csr->targets);
+  free (csr->weights);
+  free (csr);
+}
@@ -0,0 +1,71 @@
+/*
+ * Header file for our compressed sparse row (CSR) graph representation.
+ *
+ * The adjacency of vertex v occupies positions offsets[v] .. offsets[v+1]-1
+ * of the packed 'targets' and 'weights' arrays, so a traversal of all
+ * neighbours of v streams through two contiguous arrays instead of chasing
+ * EdgeList and Edge pointers.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "graph.h"
+
+#ifndef __CSR_Graph_header
+#define __CSR_Graph_header
+
+typedef struct csr_graph {
+  int numVertices;  // total number of vertices
+  int numEdges;     // total number of edges
+  int* offsets;     // numVertices+1 entries; edges of v are in
+                    //   [offsets[v], offsets[v+1])
+  int* targets;     // numEdges entries; targets[e] is the "to" vertex of e
+  int* weights;     // numEdges entries; weights[e] is the weight of e
+} CSRGraph;
+
+/***** Displaying CSR graphs ************************************************/
+
+/*
+ * Prints CSRGraph 'csr' in the same format as printGraph.
+ */
+void printCSRGraph(CSRGraph* csr);
+
+/***** Memory management ***************************************************/
+
+/*
+ * Returns a newly created CSRGraph with space for 'numVertices' vertices and
+ * 'numEdges' edges. Only offsets[0] is initialized.
+ * Precondition: numVertices >= 0, numEdges >= 0
+ */
+CSRGraph* newCSRGraph(int numVertices, int numEdges);
+
+/*
+ * Returns a newly created CSRGraph with the same vertices and edges as
+ * 'graph'. The edges of every vertex keep the order of its adjacency list.
+ */
+CSRGraph* csrFromGraph(Graph* graph);
+
+/*
+ * Returns a newly created CSRGraph with 'numVertices' vertices and the
+ * 'numEdges' edges in array 'edges', which may be in any order. Edges
+ * leaving the same vertex keep their relative order in 'edges'.
+ * Returns NULL if some edge has an endpoint that is not valid.
+ */
+CSRGraph* csrFromEdges(int numVertices, int numEdges, Edge* edges);
+
+/*
+ * Returns a newly created arena-backed Graph with the same vertices and
+ * edges as 'csr'; the adjacency list of every vertex has the order of its
+ * edges in 'csr'. All Edges, EdgeLists and Vertices are carved out of three
+ * arrays, one allocation each.
+ */
+Graph* graphFromCSR(CSRGraph* csr);
+
+/*
+ * Frees memory allocated for 'csr'.
+ */
+void deleteCSRGraph(CSRGraph* csr);
+
+#endif
@@ -0,0 +1,381 @@
+/*
+ * Our parallel delta-stepping implementation.
+ *
+ * The tentative distance and predecessor of every vertex are packed into one
+ * 64-bit word (distance in the high half) so that threads can lower both
+ * together with a single compare-and-swap. Distances are therefore ints,
+ * with INT_MAX for unreached vertices; a path that would get longer is
+ * dropped, which is what distAdd does in a 32-bit build, and a 64-bit
+ * build redoes such a run with Dijkstra's algorithm. Every thread appends
+ * the vertices it improved to its own buffer; the calling thread then moves
+ * them into their buckets between phases, so no locks are needed.
+ *
+ * An improved vertex lands at most ceil(maxWeight / delta) buckets past the
+ * current one, so the buckets form a ring of that many plus one, reused
+ * cyclically; vertices further ahead (when the ring would exceed
+ * DELTA_MAX_BUCKETS) wait in an overflow list until the ring reaches them.
+ * Empty buckets are skipped, and an empty ring jumps straight to the
+ * overflow list.
+ */
+
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "delta_stepping.h"
+#include "graph_algos.h"
+
+#define PHASE_LIGHT 0
+#define PHASE_HEAVY 1
+#define DELTA_MAX_BUCKETS (1 << 16)  // largest ring of buckets
+
+typedef struct int_vec {
+  int size;      // number of items
+  int capacity;  // number of items that fit in 'items'
+  int* items;
+} IntVec;
+
+typedef struct delta_state {
+  CSRGraph* csr;
+  int delta;                // bucket width
+  _Atomic uint64_t* best;   // best[v] is packState(distance, predecessor)
+  IntVec* frontier;         // vertices whose edges are relaxed in this phase
+  int phase;                // PHASE_LIGHT or PHASE_HEAVY
+  IntVec* updated;          // updated[t] holds the vertices thread t improved
+  atomic_bool saturated;    // whether some path got longer than INT_MAX
+} DeltaState;
+
+typedef struct bucket_ring {
+  int size;          // number of buckets in the ring
+  IntVec* buckets;   // bucket b is buckets[b % size]
+  int current;       // the bucket being processed
+  int numQueued;     // number of entries in all buckets of the ring
+  IntVec overflow;   // entries size or more buckets past 'current'
+  int overflowMin;   // no overflow entry is in a bucket below this one
+} BucketRing;
+
+/*
+ * Appends 'item' to 'vec', growing it as needed.
+ */
+static void vecPush(IntVec* vec, int item)
+{
+  if (vec->size == vec->capacity)
+  {
+    vec->capacity = vec->capacity ? 2 * vec->capacity : 16;
+    vec->items = (int *) realloc (vec->items, vec->capacity * sizeof (int));
+  }
+  vec->items[vec->size++] = item;
+}
+
+static uint64_t packState(int distance, int predecessor)
+{
+  return (uint64_t) distance << 32 | (uint32_t) predecessor;
+}
+
+static int distanceOf(uint64_t state)
+{
+  return (int) (state >> 32);
+}
+
+static int predecessorOf(uint64_t state)
+{
+  return (int) (uint32_t) state;
+}
+
+/*
+ * Team task: relaxes the light or heavy edges (per st->phase) of this
+ * thread's share of the frontier.
+ */
+static void relaxTask(void* arg, int thread, int numThreads)
+{
+  DeltaState *st = (DeltaState *) arg;
+  const int *offsets = st->csr->offsets;
+  const int *targets = st->csr->targets;
+  const int *weights = st->csr->weights;
+  bool light = st->phase == PHASE_LIGHT;
+  IntVec *out = &st->updated[thread];
+
+  int begin, end;
+  teamSlice (st->frontier->size, thread, numThreads, &begin, &end);
+  for (int i = begin; i < end; i++)
+  {
+    int u = st->frontier->items[i];
+    int du = distanceOf (atomic_load_explicit (&st->best[u],
+                                               memory_order_relaxed));
+    for (int e = offsets[u]; e < offsets[u + 1]; e++)
+    {
+      if ((weights[e] <= st->delta) != light)
+        continue;
+
+      int v = targets[e];
+      if (weights[e] >= INT_MAX - du)
+      {
+        atomic_store_explicit (&st->saturated, true, memory_order_relaxed);
+        continue;
+      }
+      int new_dist = du + weights[e];
+      uint64_t packed = packState (new_dist, u);
+      uint64_t old = atomic_load_explicit (&st->best[v], memory_order_relaxed);
+      while (distanceOf (old) > new_dist)
+      {
+        if (atomic_compare_exchange_weak (&st->best[v], &old, packed))
+        {
+          vecPush (out, v);
+          break;
+        }
+      }
+    }
+  }
+}
+
+/*
+ * Returns the bucket of vertex 'v' by its current tentative distance.
+ */
+static int bucketOf(DeltaState* st, int v)
+{
+  return distanceOf (atomic_load (&st->best[v])) / st->delta;
+}
+
+/*
+ * Queues vertex 'v' in bucket 'b' of 'ring', or in its overflow list if 'b'
+ * is too far ahead of the current bucket.
+ * Precondition: b >= ring->current
+ */
+static void ringPush(BucketRing* ring, int b, int v)
+{
+  if (b - ring->current < ring->size)
+  {
+    vecPush (&ring->buckets[b % ring->size], v);
+    ring->numQueued++;
+  }
+  else
+  {
+    vecPush (&ring->overflow, v);
+    if (b < ring->overflowMin)
+      ring->overflowMin = b;
+  }
+}
+
+/*
+ * Moves the overflow entries of 'ring' that fit into the ring now, and
+ * drops the stale ones, whose vertices have since been settled in an
+ * earlier bucket.
+ */
+static void refillRing(DeltaState* st, BucketRing* ring)
+{
+  IntVec pending = ring->overflow;
+  ring->overflow.size = 0;
+  ring->overflow.capacity = 0;
+  ring->overflow.items = NULL;
+  ring->overflowMin = INT_MAX;
+  for (int i = 0; i < pending.size; i++)
+  {
+    int b = bucketOf (st, pending.items[i]);
+    if (b >= ring->current)
+      ringPush (ring, b, pending.items[i]);
+  }
+  free (pending.items);
+}
+
+/*
+ * Moves every vertex improved in the last phase into the bucket of its new
+ * distance.
+ */
+static void mergeUpdates(DeltaState* st, int numThreads, BucketRing* ring)
+{
+  for (int t = 0; t < numThreads; t++)
+  {
+    IntVec *updated = &st->updated[t];
+    for (int i = 0; i < updated->size; i++)
+      ringPush (ring, bucketOf (st, updated->items[i]), updated->items[i]);
+    updated->size = 0;
+  }
+}
+
+/*
+ * Moves 'ring' on to the next bucket that holds entries, jumping ahead to
+ * the overflow entries once the ring is empty. Returns false if no entries
+ * are left.
+ */
+static bool nextBucket(DeltaState* st, BucketRing* ring)
+{
+  while (ring->numQueued > 0 || ring->overflow.size > 0)
+  {
+    if (ring->numQueued > 0)
+      ring->current++;
+    else
+      ring->current = ring->overflowMin > ring->current
+                      ? ring->overflowMin : ring->current + 1;
+    if (ring->current >= ring->overflowMin)
+      refillRing (st, ring);
+    if (ring->buckets[ring->current % ring->size].size > 0)
+      return true;
+  }
+  return false;
+}
+
+/*
+ * Returns the largest edge weight of 'csr', or 0 if it has no edges.
+ */
+static int maxWeight(CSRGraph* csr)
+{
+  int max = 0;
+  for (int e = 0; e < csr->numEdges; e++)
+    if (csr->weights[e] > max)
+      max = csr->weights[e];
+  return max;
+}
+
+/*
+ * Returns the average edge weight of 'csr', but at least 1.
+ */
+static int averageWeight(CSRGraph* csr)
+{
+  long long total = 0;
+  for (int e = 0; e < csr->numEdges; e++)
+    total += csr->weights[e];
+  long long avg = csr->numEdges ? total / csr->numEdges : 1;
+  return avg < 1 ? 1 : (avg > INT_MAX ? INT_MAX : (int) avg);
+}
+
+Edge* getDistanceTreeDeltaSteppingTeam(CSRGraph* csr, int startVertex,
+                                       int delta, ThreadTeam* team)
+{
+  if (!(0 <= startVertex && startVertex < csr->numVertices))
+    return NULL;
+
+  int n = csr->numVertices;
+  int numThreads = team->numThreads;
+
+  DeltaState st;
+  st.csr = csr;
+  st.delta = delta > 0 ? delta : averageWeight (csr);
+  st.best = (_Atomic uint64_t *) malloc (n * sizeof (uint64_t));
+  st.updated = (IntVec *) calloc (numThreads, sizeof (IntVec));
+  for (int v = 0; v < n; v++)
+    atomic_init (&st.best[v], packState (INT_MAX, NOTHING));
+  atomic_store (&st.best[startVertex], packState (0, NOTHING));
+  atomic_init (&st.saturated, false);
+
+  BucketRing ring = {0, NULL, 0, 0, {0, 0, NULL}, INT_MAX};
+  long long span = ((long long) maxWeight (csr) + st.delta - 1) / st.delta;
+  ring.size = span + 1 < DELTA_MAX_BUCKETS ? (int) span + 1
+                                           : DELTA_MAX_BUCKETS;
+  ring.buckets = (IntVec *) calloc (ring.size, sizeof (IntVec));
+  if (ring.buckets == NULL)
+  {
+    free (st.best);
+    free (st.updated);
+    return NULL;
+  }
+  ringPush (&ring, 0, startVertex);
+
+  /* seenIn[v] is the last light phase v was relaxed in, settledIn[v]-1 the
+   * last bucket v was removed from; both avoid duplicate work. */
+  int *seenIn = (int *) calloc (n, sizeof (int));
+  int *settledIn = (int *) calloc (n, sizeof (int));
+  IntVec frontier = {0, 0, NULL};
+  IntVec settled = {0, 0, NULL};
+  int lightPhases = 0;
+
+  do
+  {
+    int cur = ring.current;
+    IntVec *bucket = &ring.buckets[cur % ring.size];
+    settled.size = 0;
+    while (bucket->size > 0)
+    {
+      /* Take the bucket, dropping stale entries and duplicates. */
+      lightPhases++;
+      frontier.size = 0;
+      for (int i = 0; i < bucket->size; i++)
+      {
+        int v = bucket->items[i];
+        if (bucketOf (&st, v) != cur || seenIn[v] == lightPhases)
+          continue;
+        seenIn[v] = lightPhases;
+        vecPush (&frontier, v);
+        if (settledIn[v] != cur + 1)
+        {
+          settledIn[v] = cur + 1;
+          vecPush (&settled, v);
+        }
+      }
+      ring.numQueued -= bucket->size;
+      bucket->size = 0;
+
+      st.frontier = &frontier;
+      st.phase = PHASE_LIGHT;
+      teamRun (team, relaxTask, &st);
+      mergeUpdates (&st, numThreads, &ring);
+    }
+
+    /* Heavy edges cannot lead back into bucket cur. */
+    st.frontier = &settled;
+    st.phase = PHASE_HEAVY;
+    teamRun (team, relaxTask, &st);
+    mergeUpdates (&st, numThreads, &ring);
+  }
+  while (nextBucket (&st, &ring));
+
+  /* Build Distance Tree, unless some distance did not fit an int but would
+   * fit a dist_t. */
+  Edge *tree = NULL;
+  if (atomic_load (&st.saturated) && DIST_MAX > INT_MAX)
+    tree = getDistanceTreeDijkstraCSR (csr, startVertex);
+  else
+  {
+    tree = (Edge *) malloc (n * sizeof (Edge));
+    for (int v = 0; v < n; v++)
+    {
+      uint64_t state = atomic_load (&st.best[v]);
+      int distance = distanceOf (state);
+      Edge edge = {v, predecessorOf (state),
+                   distance == INT_MAX ? DIST_MAX : distance};
+      tree[v] = edge;
+    }
+    Edge start = {startVertex, startVertex, 0};
+    tree[startVertex] = start;
+  }
+
+  for (int b = 0; b < ring.size; b++)
+    free (ring.buckets[b].items);
+  for (int t = 0; t < numThreads; t++)
+    free (st.updated[t].items);
+  free (ring.buckets);
+  free (ring.overflow.items);
+  free (st.updated);
+  free (st.best);
+  free (seenIn);
+  free (settledIn);
+  free (frontier.items);
+  free (settled.items);
+
+  return tree;
+}
+
+Edge* getDistanceTreeDeltaSteppingCSR(CSRGraph* csr, int startVertex,
+                                      int delta, int numThreads)
+{
+  if (!(0 <= startVertex && startVertex < csr->numVertices))
+    return NULL;
+
+  ThreadTeam *team = newThreadTeam (numThreads);
+  Edge *tree = getDistanceTreeDeltaSteppingTeam (csr, startVertex, delta,
+                                                 team);
+  deleteThreadTeam (team);
+  return tree;
+}
+
+Edge* getDistanceTreeDeltaStepping(Graph* graph, int startVertex, int delta,
+                                   int numThreads)
+{
+  if (!(0 <= startVertex && startVertex < graph->numVertices))
+    return NULL;
+
+  CSRGraph *csr = csrFromGraph (graph);
+  Edge *tree = getDistanceTreeDeltaSteppingCSR (csr, startVertex, delta,
+                                                numThreads);
+  deleteCSRGraph (csr);
+  return tree;
+}
@@ -0,0 +1,54 @@
+/*
+ * Header file for our parallel delta-stepping single-source shortest paths.
+ *
+ * Delta-stepping keeps tentative distances in buckets of width 'delta'. All
+ * vertices of the smallest non-empty bucket are relaxed at once, in
+ * parallel: first their light edges (weight <= delta) until the bucket
+ * stays empty, then their heavy edges. A small delta behaves like Dijkstra,
+ * a large one like Bellman-Ford with more parallel work per phase.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "csr.h"
+#include "graph.h"
+#include "thread_team.h"
+
+#ifndef __DeltaStepping_header
+#define __DeltaStepping_header
+
+/*
+ * Runs delta-stepping on 'csr' from vertex with ID 'startVertex' with bucket
+ * width 'delta' on 'numThreads' threads, and returns the resulting distance
+ * tree in the same layout as getDistanceTreeDijkstra, so it can be passed to
+ * getShortestPaths. A 'delta' <= 0 selects the average edge weight.
+ * Unreachable vertices get the tree edge (id -- NOTHING, DIST_MAX).
+ * Distances are searched as ints; a vertex farther than INT_MAX counts as
+ * unreachable in a 32-bit build (like distAdd), and in a DIST_BITS=64
+ * build makes the whole query run as getDistanceTreeDijkstraCSR instead.
+ * Returns NULL if 'startVertex' is not valid in 'csr', or if the buckets
+ * could not be allocated.
+ */
+Edge* getDistanceTreeDeltaSteppingCSR(CSRGraph* csr, int startVertex,
+                                      int delta, int numThreads);
+
+/*
+ * Same as getDistanceTreeDeltaSteppingCSR, on the threads of 'team' instead
+ * of a team started and stopped for this query alone. Callers running many
+ * queries should keep one team for all of them. Only one query at a time
+ * may run on 'team'.
+ */
+Edge* getDistanceTreeDeltaSteppingTeam(CSRGraph* csr, int startVertex,
+                                       int delta, ThreadTeam* team);
+
+/*
+ * Same as getDistanceTreeDeltaSteppingCSR, on Graph 'graph'. The graph is
+ * converted to CSR first; callers running many queries should convert once
+ * and use getDistanceTreeDeltaSteppingCSR.
+ */
+Edge* getDistanceTreeDeltaStepping(Graph* graph, int startVertex, int delta,
+                                   int numThreads);
+
+#endif
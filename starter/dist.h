@@ -0,0 +1,51 @@
+/*
+ * Header file for the type of our edge weights and distances.
+ *
+ * dist_t holds Edge weights, the distances of distance trees and the
+ * priorities of the MinHeap. It is a 32-bit int by default, which keeps an
+ * Edge at 12 bytes and a HeapNode at 8. Build with -DDIST_BITS=64
+ * (make DIST_BITS=64) for 64-bit distances on graphs whose shortest paths
+ * can exceed INT_MAX; Edges and HeapNodes then take 16 bytes each.
+ *
+ * Vertex IDs, input edge weights and the offsets of CSRGraphs stay 32-bit
+ * ints in both builds, as do the keys of the bucket queues. The distances
+ * stored by ALT landmarks and the arcs of Contraction Hierarchies are
+ * dist_t, since they can be longer than any edge.
+ *
+ * Distances are added with distAdd, which saturates at DIST_MAX instead of
+ * wrapping around: a vertex farther than DIST_MAX is reported as
+ * unreachable rather than at a negative distance.
+ */
+
+#include <limits.h>
+#include <stdbool.h>
+
+#ifndef __Dist_header
+#define __Dist_header
+
+#ifndef DIST_BITS
+#define DIST_BITS 32
+#endif
+
+#if DIST_BITS == 64
+typedef long long dist_t;
+#define DIST_MAX LLONG_MAX
+#define PRIdist "lld"       // printf conversion of a dist_t, after the %
+#elif DIST_BITS == 32
+typedef int dist_t;
+#define DIST_MAX INT_MAX
+#define PRIdist "d"
+#else
+#error "DIST_BITS must be 32 or 64"
+#endif
+
+/*
+ * Returns a + b, or DIST_MAX if that is larger than DIST_MAX.
+ * Precondition: a >= 0 and b >= 0
+ */
+static inline dist_t distAdd(dist_t a, dist_t b)
+{
+  return a > DIST_MAX - b ? DIST_MAX : a + b;
+}
+
+#endif
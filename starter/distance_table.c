@@ -0,0 +1,366 @@
+/*
+ * Our many-to-many distance tables.
+ *
+ * The buckets of the CH bucket method are built in three steps: every
+ * thread runs the backward searches of its share of the targets and
+ * appends one (vertex, target, distance) entry per settled vertex to its
+ * own list; the calling thread then sorts all entries by vertex into one
+ * contiguous array, like the arcs of a CSR graph; finally every thread runs
+ * the forward searches of its block of rows. A forward search writes its
+ * row in the order it settles vertices, not in the order of the targets.
+ *
+ * The table starts on a cache line. Given enough rows, every thread's
+ * block of rows starts on one too (see rowSlice), so threads never write
+ * to the same line.
+ */
+
+#include <string.h>
+
+#include "distance_table.h"
+#include "graph_algos.h"
+#include "workspace.h"
+
+#define TABLE_LINE_SIZE 64
+
+typedef struct bucket_entry {
+  int target;       // index of the target in 'targets'
+  dist_t distance;  // distance from the bucket's vertex to that target
+} BucketEntry;
+
+typedef struct entry_vec {
+  int size;           // number of entries
+  int capacity;       // number of entries that fit in the arrays
+  int* vertices;      // vertices[k] is the bucket of entries[k]
+  BucketEntry* entries;
+} EntryVec;
+
+typedef struct table_state {
+  Graph* graph;             // the graph of getDistanceTable, or NULL
+  ContractionHierarchy* ch; // the hierarchy of getDistanceTableCH, or NULL
+  int* sources;
+  int numSources;
+  int* targets;
+  int numTargets;
+  dist_t* table;            // numSources x numTargets, row-major
+  Workspace** ws;           // ws[t] belongs to thread t
+  unsigned char* isTarget;  // isTarget[v] is 1 iff v is one of 'targets'
+  int numDistinct;          // number of distinct targets
+  EntryVec* found;          // found[t] holds the entries of thread t
+  int* bucketOffsets;       // numVertices+1 entries; the bucket of v is
+                            //   buckets[bucketOffsets[v] .. bucketOffsets[v+1]-1]
+  BucketEntry* buckets;
+} TableState;
+
+/*
+ * Appends the entry (target, distance) of the bucket of 'vertex' to 'vec',
+ * growing it as needed.
+ */
+static void vecPush(EntryVec* vec, int vertex, int target, dist_t distance)
+{
+  if (vec->size == vec->capacity)
+  {
+    vec->capacity = vec->capacity ? 2 * vec->capacity : 64;
+    vec->vertices = (int *) realloc (vec->vertices,
+                                     vec->capacity * sizeof (int));
+    vec->entries = (BucketEntry *) realloc (vec->entries, vec->capacity
+                                            * sizeof (BucketEntry));
+  }
+  vec->vertices[vec->size] = vertex;
+  vec->entries[vec->size].target = target;
+  vec->entries[vec->size].distance = distance;
+  vec->size++;
+}
+
+/*
+ * Returns true iff all 'count' vertices in 'ids' are valid vertex IDs of a
+ * graph with 'numVertices' vertices.
+ */
+static bool validVertices(int* ids, int count, int numVertices)
+{
+  for (int i = 0; i < count; i++)
+    if (ids[i] < 0 || ids[i] >= numVertices)
+      return false;
+  return true;
+}
+
+/*
+ * Returns a newly created, uninitialized table of 'numSources' x
+ * 'numTargets' distances that starts on a cache line.
+ */
+static dist_t* newTable(int numSources, int numTargets)
+{
+  // aligned_alloc needs a size that is a multiple of the alignment
+  size_t bytes = (size_t) numSources * numTargets * sizeof (dist_t);
+  bytes = (bytes / TABLE_LINE_SIZE + 1) * TABLE_LINE_SIZE;
+  return (dist_t *) aligned_alloc (TABLE_LINE_SIZE, bytes);
+}
+
+/*
+ * Sets ['begin', 'end') to the block of rows thread 'thread' out of
+ * 'numThreads' fills: contiguous, nearly equal blocks that all start on a
+ * cache line. With too few rows to give every thread a group of rows that
+ * fills whole lines, the blocks are single rows instead: sharing a line at
+ * a block boundary costs far less than leaving threads without searches.
+ */
+static void rowSlice(TableState* st, int thread, int numThreads, int* begin,
+                     int* end)
+{
+  /* Split the rows into groups of the fewest rows that fill whole lines. */
+  size_t rowBytes = (size_t) st->numTargets * sizeof (dist_t);
+  int groupRows = 1;
+  while ((groupRows * rowBytes) % TABLE_LINE_SIZE != 0)
+    groupRows++;
+  if (st->numSources < numThreads * groupRows)
+    groupRows = 1;
+
+  int numGroups = (st->numSources + groupRows - 1) / groupRows;
+  teamSlice (numGroups, thread, numThreads, begin, end);
+  *begin *= groupRows;
+  *end = *end * groupRows < st->numSources ? *end * groupRows : st->numSources;
+}
+
+/*
+ * Returns the workspace of thread 'thread', creating it on first use.
+ */
+static Workspace* threadWorkspace(TableState* st, int thread, int numVertices)
+{
+  if (st->ws[thread] == NULL)
+    st->ws[thread] = newWorkspace (numVertices);
+  return st->ws[thread];
+}
+
+/*
+ * Team task: fills this thread's block of rows with Dijkstra searches that
+ * stop once every target is settled.
+ */
+static void dijkstraRowsTask(void* arg, int thread, int numThreads)
+{
+  TableState *st = (TableState *) arg;
+  Graph *graph = st->graph;
+  Workspace *ws = threadWorkspace (st, thread, graph->numVertices);
+
+  int begin, end;
+  rowSlice (st, thread, numThreads, &begin, &end);
+  for (int i = begin; i < end; i++)
+  {
+    resetWorkspace (ws);
+    wsRelax (ws, st->sources[i], 0, NOTHING);
+    int settledTargets = 0;
+    while (ws->heap->size > 0 && settledTargets < st->numDistinct)
+    {
+      HeapNode u = wsSettleNext (ws);
+      settledTargets += st->isTarget[u.id];
+      for (EdgeList *l = graph->vertices[u.id]->adjList; l != NULL;
+           l = l->next)
+        wsRelax (ws, l->edge->toVertex, distAdd (u.priority, l->edge->weight),
+                 u.id);
+    }
+
+    /* Every target is settled now, or unreachable. */
+    dist_t *row = st->table + (size_t) i * st->numTargets;
+    for (int j = 0; j < st->numTargets; j++)
+      row[j] = wsDistance (ws, st->targets[j]);
+  }
+}
+
+dist_t* getDistanceTableTeam(Graph* graph, int* sources, int numSources,
+                             int* targets, int numTargets, ThreadTeam* team)
+{
+  int n = graph->numVertices;
+  if (!validVertices (sources, numSources, n)
+      || !validVertices (targets, numTargets, n))
+    return NULL;
+
+  TableState st;
+  memset (&st, 0, sizeof (TableState));
+  st.graph = graph;
+  st.sources = sources;
+  st.numSources = numSources;
+  st.targets = targets;
+  st.numTargets = numTargets;
+  st.table = newTable (numSources, numTargets);
+  st.isTarget = (unsigned char *) calloc (n, sizeof (unsigned char));
+  for (int j = 0; j < numTargets; j++)
+    if (!st.isTarget[targets[j]])
+    {
+      st.isTarget[targets[j]] = 1;
+      st.numDistinct++;
+    }
+
+  st.ws = (Workspace **) calloc (team->numThreads, sizeof (Workspace *));
+  teamRun (team, dijkstraRowsTask, &st);
+
+  for (int t = 0; t < team->numThreads; t++)
+    if (st.ws[t] != NULL)
+      deleteWorkspace (st.ws[t]);
+  free (st.ws);
+  free (st.isTarget);
+  return st.table;
+}
+
+dist_t* getDistanceTable(Graph* graph, int* sources, int numSources,
+                         int* targets, int numTargets, int numThreads)
+{
+  ThreadTeam *team = newThreadTeam (numThreads);
+  dist_t *table = getDistanceTableTeam (graph, sources, numSources, targets,
+                                        numTargets, team);
+  deleteThreadTeam (team);
+  return table;
+}
+
+/*
+ * Runs the upward search of 'ch' from 'start' in Workspace 'ws': forward
+ * over the up arcs, or backward over the down arcs. Leaves every vertex it
+ * reaches settled in 'ws', in the order of ws->touched.
+ */
+static void upwardSearch(ContractionHierarchy* ch, Workspace* ws, int start,
+                         bool forward)
+{
+  int *offsets = forward ? ch->upOffsets : ch->downOffsets;
+  CHArc *arcs = forward ? ch->upArcs : ch->downArcs;
+
+  resetWorkspace (ws);
+  wsRelax (ws, start, 0, NOTHING);
+  while (ws->heap->size > 0)
+  {
+    HeapNode u = wsSettleNext (ws);
+    for (int a = offsets[u.id]; a < offsets[u.id + 1]; a++)
+      wsRelax (ws, arcs[a].target, distAdd (u.priority, arcs[a].weight),
+               u.id);
+  }
+}
+
+/*
+ * Team task: runs the backward searches of this thread's share of the
+ * targets and records their bucket entries in st->found[thread].
+ */
+static void backwardTask(void* arg, int thread, int numThreads)
+{
+  TableState *st = (TableState *) arg;
+  Workspace *ws = threadWorkspace (st, thread, st->ch->numVertices);
+  EntryVec *found = &st->found[thread];
+
+  int begin, end;
+  teamSlice (st->numTargets, thread, numThreads, &begin, &end);
+  for (int j = begin; j < end; j++)
+  {
+    upwardSearch (st->ch, ws, st->targets[j], false);
+    for (int k = 0; k < ws->numTouched; k++)
+    {
+      int v = ws->touched[k];
+      vecPush (found, v, j, ws->distances[v]);
+    }
+  }
+}
+
+/*
+ * Sorts the entries of all threads by vertex into st->buckets, keeping the
+ * order of the threads and of their entries, and frees the lists.
+ */
+static void fillBuckets(TableState* st, int numThreads)
+{
+  int n = st->ch->numVertices;
+  int *offsets = (int *) calloc (n + 1, sizeof (int));
+  int total = 0;
+  for (int t = 0; t < numThreads; t++)
+  {
+    for (int k = 0; k < st->found[t].size; k++)
+      offsets[st->found[t].vertices[k] + 1]++;
+    total += st->found[t].size;
+  }
+  for (int v = 0; v < n; v++)
+    offsets[v + 1] += offsets[v];
+
+  BucketEntry *buckets = (BucketEntry *) malloc ((total ? total : 1)
+                                                 * sizeof (BucketEntry));
+  int *next = (int *) malloc (n * sizeof (int));
+  memcpy (next, offsets, n * sizeof (int));
+  for (int t = 0; t < numThreads; t++)
+  {
+    EntryVec *found = &st->found[t];
+    for (int k = 0; k < found->size; k++)
+      buckets[next[found->vertices[k]]++] = found->entries[k];
+    free (found->vertices);
+    free (found->entries);
+  }
+  free (next);
+  st->bucketOffsets = offsets;
+  st->buckets = buckets;
+}
+
+/*
+ * Team task: fills this thread's block of rows with the forward searches
+ * of its sources and the buckets of the vertices they settle.
+ */
+static void forwardTask(void* arg, int thread, int numThreads)
+{
+  TableState *st = (TableState *) arg;
+  Workspace *ws = threadWorkspace (st, thread, st->ch->numVertices);
+
+  int begin, end;
+  rowSlice (st, thread, numThreads, &begin, &end);
+  for (int i = begin; i < end; i++)
+  {
+    dist_t *row = st->table + (size_t) i * st->numTargets;
+    for (int j = 0; j < st->numTargets; j++)
+      row[j] = DIST_MAX;
+
+    upwardSearch (st->ch, ws, st->sources[i], true);
+    for (int k = 0; k < ws->numTouched; k++)
+    {
+      int v = ws->touched[k];
+      dist_t d = ws->distances[v];
+      for (int e = st->bucketOffsets[v]; e < st->bucketOffsets[v + 1]; e++)
+      {
+        dist_t through = distAdd (d, st->buckets[e].distance);
+        if (through < row[st->buckets[e].target])
+          row[st->buckets[e].target] = through;
+      }
+    }
+  }
+}
+
+dist_t* getDistanceTableCHTeam(ContractionHierarchy* ch, int* sources,
+                               int numSources, int* targets, int numTargets,
+                               ThreadTeam* team)
+{
+  int n = ch->numVertices;
+  if (!validVertices (sources, numSources, n)
+      || !validVertices (targets, numTargets, n))
+    return NULL;
+
+  TableState st;
+  memset (&st, 0, sizeof (TableState));
+  st.ch = ch;
+  st.sources = sources;
+  st.numSources = numSources;
+  st.targets = targets;
+  st.numTargets = numTargets;
+  st.table = newTable (numSources, numTargets);
+
+  st.ws = (Workspace **) calloc (team->numThreads, sizeof (Workspace *));
+  st.found = (EntryVec *) calloc (team->numThreads, sizeof (EntryVec));
+  teamRun (team, backwardTask, &st);
+  fillBuckets (&st, team->numThreads);
+  teamRun (team, forwardTask, &st);
+
+  for (int t = 0; t < team->numThreads; t++)
+    if (st.ws[t] != NULL)
+      deleteWorkspace (st.ws[t]);
+  free (st.ws);
+  free (st.found);
+  free (st.bucketOffsets);
+  free (st.buckets);
+  return st.table;
+}
+
+dist_t* getDistanceTableCH(ContractionHierarchy* ch, int* sources,
+                           int numSources, int* targets, int numTargets,
+                           int numThreads)
+{
+  ThreadTeam *team = newThreadTeam (numThreads);
+  dist_t *table = getDistanceTableCHTeam (ch, sources, numSources, targets,
+                                          numTargets, team);
+  deleteThreadTeam (team);
+  return table;
+}
@@ -0,0 +1,70 @@
+/*
+ * Header file for our many-to-many distance tables.
+ *
+ * A distance table holds distance(sources[i], targets[j]) for every one of
+ * N sources and M targets, as a dense row-major array of N x M dist_t:
+ * table[i * M + j]. Unreachable pairs are DIST_MAX. Rows are filled on a
+ * team of threads, each thread owning a contiguous block of rows. The table
+ * starts on a cache line, and so does every block when there are enough
+ * rows for each thread to get whole lines.
+ *
+ * getDistanceTable runs one Dijkstra search per source that stops as soon
+ * as every target is settled. getDistanceTableCH uses the bucket method on
+ * a Contraction Hierarchy: one upward search backward from every target
+ * leaves (target, distance) entries in buckets at the vertices it settles,
+ * then one upward search forward from every source scans the buckets of
+ * the vertices it settles. Both searches only see a small part of the
+ * graph, so this is much faster when N and M are large.
+ *
+ *   dist_t *table = getDistanceTable (graph, sources, 100, targets, 50, 4);
+ *   printf ("%d\n", (int) table[3 * 50 + 7]);   // sources[3] to targets[7]
+ *   free (table);
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ch.h"
+#include "graph.h"
+#include "thread_team.h"
+
+#ifndef __Distance_Table_header
+#define __Distance_Table_header
+
+/*
+ * Returns a newly created table of the distances from each of the
+ * 'numSources' vertices in 'sources' to each of the 'numTargets' vertices
+ * in 'targets' in Graph 'graph', computed on 'numThreads' threads.
+ * Returns NULL if a source or target is not valid in 'graph'.
+ */
+dist_t* getDistanceTable(Graph* graph, int* sources, int numSources,
+                         int* targets, int numTargets, int numThreads);
+
+/*
+ * Same as getDistanceTable, but uses the bucket method on the hierarchy
+ * 'ch' of the graph.
+ * Returns NULL if a source or target is not valid in 'ch'.
+ */
+dist_t* getDistanceTableCH(ContractionHierarchy* ch, int* sources,
+                           int numSources, int* targets, int numTargets,
+                           int numThreads);
+
+/*
+ * Same as getDistanceTable, on the threads of 'team' instead of a team
+ * started and stopped for this table alone. Callers computing many tables
+ * should keep one team for all of them. Only one table at a time may be
+ * computed on 'team'.
+ */
+dist_t* getDistanceTableTeam(Graph* graph, int* sources, int numSources,
+                             int* targets, int numTargets, ThreadTeam* team);
+
+/*
+ * Same as getDistanceTableCH, on the threads of 'team', like
+ * getDistanceTableTeam.
+ */
+dist_t* getDistanceTableCHTeam(ContractionHierarchy* ch, int* sources,
+                               int numSources, int* targets, int numTargets,
+                               ThreadTeam* team);
+
+#endif
@@ -0,0 +1,717 @@
+/*
+ * Our dynamic minimum spanning forest.
+ *
+ * The link-cut tree has one node per vertex, IDs 0 .. numVertices-1, and
+ * one node per edge, ID numVertices + edge index; a tree edge is linked
+ * between the nodes of its two vertices. Every node keeps the node of the
+ * heaviest edge in its splay subtree; vertex nodes weigh -1.
+ *
+ * Edges are kept in an array and found through an open-addressing hash
+ * table keyed by their endpoints. A deleted edge stays in the array, marked
+ * not alive, and is revived if the same edge is inserted again, so the
+ * table never has to delete. Every edge is linked into the incidence lists
+ * of both its vertices. Once more than half of the array is deleted edges,
+ * compactEdges drops them all and renumbers the rest, so memory and the
+ * replacement searches stay proportional to the current graph.
+ */
+
+#include <string.h>
+
+#include "dynamic_mst.h"
+#include "graph_algos.h"
+
+#define INITIAL_EDGES 16
+
+typedef struct mst_edge {
+  int u;            // endpoints; u < v
+  int v;
+  dist_t weight;
+  int nextU;        // next edge in the incidence list of u, or NOTHING
+  int nextV;        // next edge in the incidence list of v, or NOTHING
+  bool inTree;      // true iff the edge is in the forest
+  bool alive;       // false once the edge is deleted
+} MSTEdge;
+
+typedef struct lct_node {
+  int child[2];     // children in the splay tree, or NOTHING
+  int parent;       // splay parent, or path-parent if this is a splay root
+  int max;          // the node of the heaviest edge in this splay subtree
+  bool flip;        // the children of this subtree are to be swapped
+} LCTNode;
+
+struct dynamic_mst {
+  int numVertices;
+  MSTEdge* edges;
+  int numEdges;         // entries in 'edges', alive or not
+  int numDead;          // entries in 'edges' that are not alive
+  int edgeCapacity;
+  int* firstEdge;       // firstEdge[id] heads the incidence list of id
+  int* table;           // hash table of edge indices, NOTHING if empty
+  int tableSize;        // a power of two, at least twice numEdges
+  LCTNode* nodes;       // numVertices + edgeCapacity link-cut tree nodes
+  int* splayStack;      // scratch space for splay
+  unsigned epoch;       // stamp of the current replacement search
+  unsigned* seen[2];    // seen[side][id] == epoch iff the search of 'side'
+                        //   reached vertex id
+  int* queue[2];        // the vertices reached by each search, in order
+  long long totalWeight;
+  int numTreeEdges;
+};
+
+/*************************************************************************
+ ** Link-cut tree
+ *************************************************************************/
+
+/*
+ * Returns the weight of link-cut tree node 'x'.
+ */
+static dist_t nodeWeight(DynamicMST* dyn, int x)
+{
+  return x < dyn->numVertices ? -1 : dyn->edges[x - dyn->numVertices].weight;
+}
+
+static bool isSplayRoot(DynamicMST* dyn, int x)
+{
+  int p = dyn->nodes[x].parent;
+  return p == NOTHING
+         || (dyn->nodes[p].child[0] != x && dyn->nodes[p].child[1] != x);
+}
+
+/*
+ * Recomputes the heaviest edge node of the splay subtree of 'x'.
+ */
+static void updateNode(DynamicMST* dyn, int x)
+{
+  LCTNode *node = &dyn->nodes[x];
+  node->max = x;
+  for (int i = 0; i < 2; i++)
+  {
+    int c = node->child[i];
+    if (c != NOTHING
+        && nodeWeight (dyn, dyn->nodes[c].max) > nodeWeight (dyn, node->max))
+      node->max = dyn->nodes[c].max;
+  }
+}
+
+/*
+ * Swaps the children of 'x' if it is flipped, and passes the flip on.
+ */
+static void pushDown(DynamicMST* dyn, int x)
+{
+  LCTNode *node = &dyn->nodes[x];
+  if (!node->flip)
+    return;
+  int tmp = node->child[0];
+  node->child[0] = node->child[1];
+  node->child[1] = tmp;
+  for (int i = 0; i < 2; i++)
+    if (node->child[i] != NOTHING)
+      dyn->nodes[node->child[i]].flip ^= true;
+  node->flip = false;
+}
+
+static void rotate(DynamicMST* dyn, int x)
+{
+  LCTNode *nodes = dyn->nodes;
+  int y = nodes[x].parent;
+  int z = nodes[y].parent;
+  int dx = nodes[y].child[1] == x;
+
+  if (!isSplayRoot (dyn, y))
+    nodes[z].child[nodes[z].child[1] == y] = x;
+  nodes[x].parent = z;
+  nodes[y].child[dx] = nodes[x].child[!dx];
+  if (nodes[x].child[!dx] != NOTHING)
+    nodes[nodes[x].child[!dx]].parent = y;
+  nodes[x].child[!dx] = y;
+  nodes[y].parent = x;
+  updateNode (dyn, y);
+  updateNode (dyn, x);
+}
+
+/*
+ * Makes 'x' the root of its splay tree.
+ */
+static void splay(DynamicMST* dyn, int x)
+{
+  /* Pending flips are pushed down from the splay root first. */
+  int top = 0;
+  dyn->splayStack[top++] = x;
+  for (int y = x; !isSplayRoot (dyn, y); y = dyn->nodes[y].parent)
+    dyn->splayStack[top++] = dyn->nodes[y].parent;
+  while (top > 0)
+    pushDown (dyn, dyn->splayStack[--top]);
+
+  while (!isSplayRoot (dyn, x))
+  {
+    int y = dyn->nodes[x].parent;
+    if (!isSplayRoot (dyn, y))
+    {
+      int z = dyn->nodes[y].parent;
+      bool zigZig = (dyn->nodes[y].child[0] == x)
+                    == (dyn->nodes[z].child[0] == y);
+      rotate (dyn, zigZig ? y : x);
+    }
+    rotate (dyn, x);
+  }
+}
+
+/*
+ * Makes the path from the root of the tree of 'x' to 'x' one splay tree,
+ * rooted at 'x'.
+ */
+static void accessNode(DynamicMST* dyn, int x)
+{
+  int last = NOTHING;
+  for (int y = x; y != NOTHING; y = dyn->nodes[y].parent)
+  {
+    splay (dyn, y);
+    dyn->nodes[y].child[1] = last;
+    updateNode (dyn, y);
+    last = y;
+  }
+  splay (dyn, x);
+}
+
+static void makeRoot(DynamicMST* dyn, int x)
+{
+  accessNode (dyn, x);
+  dyn->nodes[x].flip ^= true;
+}
+
+static int findRoot(DynamicMST* dyn, int x)
+{
+  accessNode (dyn, x);
+  pushDown (dyn, x);
+  while (dyn->nodes[x].child[0] != NOTHING)
+  {
+    x = dyn->nodes[x].child[0];
+    pushDown (dyn, x);
+  }
+  splay (dyn, x);
+  return x;
+}
+
+static void linkNodes(DynamicMST* dyn, int x, int y)
+{
+  makeRoot (dyn, x);
+  dyn->nodes[x].parent = y;
+}
+
+/*
+ * Removes the link between the adjacent nodes 'x' and 'y'.
+ */
+static void cutNodes(DynamicMST* dyn, int x, int y)
+{
+  makeRoot (dyn, x);
+  accessNode (dyn, y);
+  /* x is now the left child of y, with nothing between them. */
+  dyn->nodes[y].child[0] = NOTHING;
+  dyn->nodes[x].parent = NOTHING;
+  updateNode (dyn, y);
+}
+
+/*
+ * Returns the index of the heaviest edge on the tree path between the
+ * distinct connected vertices 'u' and 'v'.
+ */
+static int heaviestOnPath(DynamicMST* dyn, int u, int v)
+{
+  makeRoot (dyn, u);
+  accessNode (dyn, v);
+  return dyn->nodes[v].max - dyn->numVertices;
+}
+
+/*************************************************************************
+ ** Edges
+ *************************************************************************/
+
+/*
+ * Returns the slot of edge (u -- v) in the hash table: the slot holding
+ * it, or the empty slot where it belongs.
+ * Precondition: u < v
+ */
+static int findSlot(DynamicMST* dyn, int u, int v)
+{
+  unsigned long long key = ((unsigned long long) u << 32) | (unsigned) v;
+  int mask = dyn->tableSize - 1;
+  int slot = (int) ((key * 0x9E3779B97F4A7C15ULL) >> 33) & mask;
+  while (dyn->table[slot] != NOTHING)
+  {
+    MSTEdge *e = &dyn->edges[dyn->table[slot]];
+    if (e->u == u && e->v == v)
+      break;
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+/*
+ * Returns the index of edge (u -- v), alive or not, or NOTHING.
+ */
+static int findEdgeIndex(DynamicMST* dyn, int u, int v)
+{
+  if (u > v)
+  {
+    int tmp = u;
+    u = v;
+    v = tmp;
+  }
+  return dyn->table[findSlot (dyn, u, v)];
+}
+
+/*
+ * Makes room for one more edge, growing the edge array, the link-cut tree
+ * and the hash table if needed.
+ */
+static void reserveEdge(DynamicMST* dyn)
+{
+  if (dyn->numEdges == dyn->edgeCapacity)
+  {
+    int n = dyn->numVertices;
+    int capacity = 2 * dyn->edgeCapacity;
+    dyn->edges = (MSTEdge *) realloc (dyn->edges, capacity * sizeof (MSTEdge));
+    dyn->nodes = (LCTNode *) realloc (dyn->nodes,
+                                      (n + capacity) * sizeof (LCTNode));
+    dyn->splayStack = (int *) realloc (dyn->splayStack,
+                                       (n + capacity) * sizeof (int));
+    for (int x = n + dyn->edgeCapacity; x < n + capacity; x++)
+      dyn->nodes[x] = (LCTNode) { { NOTHING, NOTHING }, NOTHING, x, false };
+    dyn->edgeCapacity = capacity;
+  }
+
+  if (2 * (dyn->numEdges + 1) > dyn->tableSize)
+  {
+    free (dyn->table);
+    dyn->tableSize *= 2;
+    dyn->table = (int *) malloc (dyn->tableSize * sizeof (int));
+    for (int slot = 0; slot < dyn->tableSize; slot++)
+      dyn->table[slot] = NOTHING;
+    for (int e = 0; e < dyn->numEdges; e++)
+      dyn->table[findSlot (dyn, dyn->edges[e].u, dyn->edges[e].v)] = e;
+  }
+}
+
+/*
+ * Adds the non-tree edge (u -- v, weight) and returns its index.
+ * Precondition: u < v, and the edge does not exist
+ */
+static int addEdge(DynamicMST* dyn, int u, int v, dist_t weight)
+{
+  reserveEdge (dyn);
+  int e = dyn->numEdges++;
+  dyn->edges[e] = (MSTEdge) { u, v, weight, dyn->firstEdge[u],
+                              dyn->firstEdge[v], false, true };
+  dyn->firstEdge[u] = e;
+  dyn->firstEdge[v] = e;
+  dyn->table[findSlot (dyn, u, v)] = e;
+  return e;
+}
+
+/*
+ * Returns the edge after 'e' in the incidence list of vertex 'x'.
+ */
+static int nextEdge(DynamicMST* dyn, int e, int x)
+{
+  return dyn->edges[e].u == x ? dyn->edges[e].nextU : dyn->edges[e].nextV;
+}
+
+/*
+ * Returns the endpoint of edge 'e' that is not 'x'.
+ */
+static int otherEnd(DynamicMST* dyn, int e, int x)
+{
+  return dyn->edges[e].u == x ? dyn->edges[e].v : dyn->edges[e].u;
+}
+
+/*
+ * Adds edge 'e' to the forest.
+ */
+static void addTreeEdge(DynamicMST* dyn, int e)
+{
+  MSTEdge *edge = &dyn->edges[e];
+  int node = dyn->numVertices + e;
+  edge->inTree = true;
+  dyn->nodes[node] = (LCTNode) { { NOTHING, NOTHING }, NOTHING, node, false };
+  linkNodes (dyn, edge->u, node);
+  linkNodes (dyn, node, edge->v);
+  dyn->totalWeight += edge->weight;
+  dyn->numTreeEdges++;
+}
+
+/*
+ * Removes edge 'e' from the forest.
+ */
+static void removeTreeEdge(DynamicMST* dyn, int e)
+{
+  MSTEdge *edge = &dyn->edges[e];
+  int node = dyn->numVertices + e;
+  edge->inTree = false;
+  cutNodes (dyn, edge->u, node);
+  cutNodes (dyn, node, edge->v);
+  dyn->totalWeight -= edge->weight;
+  dyn->numTreeEdges--;
+}
+
+/*
+ * Adds the alive non-tree edge 'e' to the forest if it connects two trees,
+ * or if it is lighter than the heaviest edge on the tree path between its
+ * endpoints, which it then replaces.
+ */
+static void offerEdge(DynamicMST* dyn, int e)
+{
+  int u = dyn->edges[e].u;
+  int v = dyn->edges[e].v;
+  if (findRoot (dyn, u) != findRoot (dyn, v))
+  {
+    addTreeEdge (dyn, e);
+    return;
+  }
+
+  int heaviest = heaviestOnPath (dyn, u, v);
+  if (dyn->edges[heaviest].weight > dyn->edges[e].weight)
+  {
+    removeTreeEdge (dyn, heaviest);
+    addTreeEdge (dyn, e);
+  }
+}
+
+/*
+ * Returns the lightest alive non-tree edge between the tree of 'a' and the
+ * tree of 'b', or NOTHING if there is none. Searches both trees in
+ * lockstep, and scans the edges of the one that is exhausted first.
+ * Precondition: 'a' and 'b' are in different trees
+ */
+static int findReplacement(DynamicMST* dyn, int a, int b)
+{
+  if (++dyn->epoch == 0)
+  {
+    /* The stamps wrapped around: old stamps could collide, clear them. */
+    for (int side = 0; side < 2; side++)
+      memset (dyn->seen[side], 0, dyn->numVertices * sizeof (unsigned));
+    dyn->epoch = 1;
+  }
+
+  int start[2] = { a, b };
+  int head[2] = { 0, 0 };
+  int size[2] = { 1, 1 };
+  for (int side = 0; side < 2; side++)
+  {
+    dyn->queue[side][0] = start[side];
+    dyn->seen[side][start[side]] = dyn->epoch;
+  }
+
+  int done = NOTHING;
+  while (done == NOTHING)
+    for (int side = 0; side < 2 && done == NOTHING; side++)
+    {
+      if (head[side] == size[side])
+      {
+        done = side;
+        break;
+      }
+      int x = dyn->queue[side][head[side]++];
+      for (int e = dyn->firstEdge[x]; e != NOTHING; e = nextEdge (dyn, e, x))
+      {
+        int y = otherEnd (dyn, e, x);
+        if (dyn->edges[e].inTree && dyn->seen[side][y] != dyn->epoch)
+        {
+          dyn->seen[side][y] = dyn->epoch;
+          dyn->queue[side][size[side]++] = y;
+        }
+      }
+    }
+
+  int best = NOTHING;
+  for (int i = 0; i < size[done]; i++)
+  {
+    int x = dyn->queue[done][i];
+    for (int e = dyn->firstEdge[x]; e != NOTHING; e = nextEdge (dyn, e, x))
+    {
+      MSTEdge *edge = &dyn->edges[e];
+      if (edge->alive && !edge->inTree
+          && dyn->seen[done][otherEnd (dyn, e, x)] != dyn->epoch
+          && (best == NOTHING || edge->weight < dyn->edges[best].weight))
+        best = e;
+    }
+  }
+  return best;
+}
+
+/*
+ * Removes the tree edge 'e' from the forest, sets its weight to 'weight',
+ * and adds the lightest edge that reconnects its endpoints instead, if
+ * there is one. 'e' itself is a candidate if it is still alive.
+ */
+static void replaceTreeEdge(DynamicMST* dyn, int e, dist_t weight)
+{
+  removeTreeEdge (dyn, e);
+  dyn->edges[e].weight = weight;
+  int replacement = findReplacement (dyn, dyn->edges[e].u, dyn->edges[e].v);
+  if (replacement != NOTHING)
+    addTreeEdge (dyn, replacement);
+}
+
+/*
+ * Returns the node that link-cut tree node 'x' is renumbered to when edge
+ * e becomes edge newIndex[e], or NOTHING if 'x' is NOTHING.
+ */
+static int renumberNode(DynamicMST* dyn, int* newIndex, int x)
+{
+  if (x == NOTHING || x < dyn->numVertices)
+    return x;
+  return dyn->numVertices + newIndex[x - dyn->numVertices];
+}
+
+/*
+ * Removes every edge that is not alive from the edge array, the hash
+ * table, the incidence lists and the link-cut tree, renumbering the alive
+ * edges in order, and shrinks the arrays to fit them.
+ */
+static void compactEdges(DynamicMST* dyn)
+{
+  int n = dyn->numVertices;
+  int *newIndex = (int *) malloc (dyn->numEdges * sizeof (int));
+  int count = 0;
+  for (int e = 0; e < dyn->numEdges; e++)
+  {
+    /* This empties the incidence list of every vertex that has one. */
+    dyn->firstEdge[dyn->edges[e].u] = NOTHING;
+    dyn->firstEdge[dyn->edges[e].v] = NOTHING;
+    newIndex[e] = dyn->edges[e].alive ? count++ : NOTHING;
+  }
+
+  /* Only tree edges are linked, and they are alive, so the nodes of the
+   * dead edges have no links and every link survives the renumbering. */
+  for (int x = 0; x < n + dyn->numEdges; x++)
+  {
+    if (x >= n && newIndex[x - n] == NOTHING)
+      continue;
+    LCTNode node = dyn->nodes[x];
+    for (int i = 0; i < 2; i++)
+      node.child[i] = renumberNode (dyn, newIndex, node.child[i]);
+    node.parent = renumberNode (dyn, newIndex, node.parent);
+    node.max = renumberNode (dyn, newIndex, node.max);
+    dyn->nodes[renumberNode (dyn, newIndex, x)] = node;
+  }
+
+  for (int e = 0; e < dyn->numEdges; e++)
+    if (newIndex[e] != NOTHING)
+    {
+      MSTEdge edge = dyn->edges[e];
+      edge.nextU = dyn->firstEdge[edge.u];
+      edge.nextV = dyn->firstEdge[edge.v];
+      dyn->edges[newIndex[e]] = edge;
+      dyn->firstEdge[edge.u] = newIndex[e];
+      dyn->firstEdge[edge.v] = newIndex[e];
+    }
+  free (newIndex);
+  dyn->numEdges = count;
+  dyn->numDead = 0;
+
+  int capacity = INITIAL_EDGES;
+  while (capacity < 2 * count)
+    capacity *= 2;
+  if (capacity < dyn->edgeCapacity)
+  {
+    dyn->edges = (MSTEdge *) realloc (dyn->edges, capacity * sizeof (MSTEdge));
+    dyn->nodes = (LCTNode *) realloc (dyn->nodes,
+                                      (n + capacity) * sizeof (LCTNode));
+    dyn->splayStack = (int *) realloc (dyn->splayStack,
+                                       (n + capacity) * sizeof (int));
+    dyn->edgeCapacity = capacity;
+  }
+  for (int x = n + count; x < n + dyn->edgeCapacity; x++)
+    dyn->nodes[x] = (LCTNode) { { NOTHING, NOTHING }, NOTHING, x, false };
+
+  free (dyn->table);
+  dyn->tableSize = 2 * dyn->edgeCapacity;
+  dyn->table = (int *) malloc (dyn->tableSize * sizeof (int));
+  for (int slot = 0; slot < dyn->tableSize; slot++)
+    dyn->table[slot] = NOTHING;
+  for (int e = 0; e < dyn->numEdges; e++)
+    dyn->table[findSlot (dyn, dyn->edges[e].u, dyn->edges[e].v)] = e;
+}
+
+/*************************************************************************
+ ** Public functions
+ *************************************************************************/
+
+DynamicMST* newDynamicMST(Graph* graph, Edge* mst, int numTreeEdges)
+{
+  int n = graph->numVertices;
+  DynamicMST *dyn = (DynamicMST *) malloc (sizeof (DynamicMST));
+  dyn->numVertices = n;
+  dyn->numEdges = 0;
+  dyn->numDead = 0;
+  dyn->edgeCapacity = INITIAL_EDGES;
+  while (dyn->edgeCapacity < graph->numEdges / 2)
+    dyn->edgeCapacity *= 2;
+  dyn->edges = (MSTEdge *) malloc (dyn->edgeCapacity * sizeof (MSTEdge));
+  dyn->firstEdge = (int *) malloc (n * sizeof (int));
+  dyn->tableSize = 2 * dyn->edgeCapacity;
+  dyn->table = (int *) malloc (dyn->tableSize * sizeof (int));
+  dyn->nodes = (LCTNode *) malloc ((n + dyn->edgeCapacity) * sizeof (LCTNode));
+  dyn->splayStack = (int *) malloc ((n + dyn->edgeCapacity) * sizeof (int));
+  dyn->epoch = 0;
+  for (int side = 0; side < 2; side++)
+  {
+    dyn->seen[side] = (unsigned *) calloc (n, sizeof (unsigned));
+    dyn->queue[side] = (int *) malloc (n * sizeof (int));
+  }
+  dyn->totalWeight = 0;
+  dyn->numTreeEdges = 0;
+
+  for (int id = 0; id < n; id++)
+    dyn->firstEdge[id] = NOTHING;
+  for (int slot = 0; slot < dyn->tableSize; slot++)
+    dyn->table[slot] = NOTHING;
+  for (int x = 0; x < n + dyn->edgeCapacity; x++)
+    dyn->nodes[x] = (LCTNode) { { NOTHING, NOTHING }, NOTHING, x, false };
+
+  /* Every undirected edge is added once, from its smaller endpoint. */
+  for (int u = 0; u < n; u++)
+    for (EdgeList *l = graph->vertices[u]->adjList; l != NULL; l = l->next)
+    {
+      int v = l->edge->toVertex;
+      if (v <= u)
+        continue;
+      int e = findEdgeIndex (dyn, u, v);
+      if (e == NOTHING)
+        addEdge (dyn, u, v, l->edge->weight);
+      else if (l->edge->weight < dyn->edges[e].weight)
+        dyn->edges[e].weight = l->edge->weight;
+    }
+
+  for (int i = 0; i < numTreeEdges; i++)
+  {
+    int u = mst[i].fromVertex;
+    int v = mst[i].toVertex;
+    if (v == NOTHING || u == v)
+      continue;
+    int e = findEdgeIndex (dyn, u, v);
+    if (e != NOTHING && !dyn->edges[e].inTree)
+      addTreeEdge (dyn, e);
+  }
+  return dyn;
+}
+
+bool insertMSTEdge(DynamicMST* dyn, int u, int v, dist_t weight)
+{
+  if (u < 0 || u >= dyn->numVertices || v < 0 || v >= dyn->numVertices
+      || u == v || weight < 0)
+    return false;
+  if (u > v)
+  {
+    int tmp = u;
+    u = v;
+    v = tmp;
+  }
+
+  int e = findEdgeIndex (dyn, u, v);
+  if (e != NOTHING && dyn->edges[e].alive)
+    return false;
+  if (e == NOTHING)
+    e = addEdge (dyn, u, v, weight);
+  else
+  {
+    dyn->edges[e].alive = true;
+    dyn->edges[e].weight = weight;
+    dyn->numDead--;
+  }
+  offerEdge (dyn, e);
+  return true;
+}
+
+bool deleteMSTEdge(DynamicMST* dyn, int u, int v)
+{
+  if (u < 0 || u >= dyn->numVertices || v < 0 || v >= dyn->numVertices
+      || u == v)
+    return false;
+  int e = findEdgeIndex (dyn, u, v);
+  if (e == NOTHING || !dyn->edges[e].alive)
+    return false;
+
+  dyn->edges[e].alive = false;
+  dyn->numDead++;
+  if (dyn->edges[e].inTree)
+    replaceTreeEdge (dyn, e, dyn->edges[e].weight);
+  if (dyn->numDead >= INITIAL_EDGES && 2 * dyn->numDead > dyn->numEdges)
+    compactEdges (dyn);
+  return true;
+}
+
+bool reweightMSTEdge(DynamicMST* dyn, int u, int v, dist_t weight)
+{
+  if (u < 0 || u >= dyn->numVertices || v < 0 || v >= dyn->numVertices
+      || u == v || weight < 0)
+    return false;
+  int e = findEdgeIndex (dyn, u, v);
+  if (e == NOTHING || !dyn->edges[e].alive)
+    return false;
+
+  MSTEdge *edge = &dyn->edges[e];
+  dist_t old = edge->weight;
+  if (!edge->inTree)
+  {
+    edge->weight = weight;
+    if (weight < old)
+      offerEdge (dyn, e);
+  }
+  else if (weight <= old)
+  {
+    /* A lighter tree edge stays; only the maxima above its node change. */
+    int node = dyn->numVertices + e;
+    accessNode (dyn, node);
+    edge->weight = weight;
+    updateNode (dyn, node);
+    dyn->totalWeight += weight - old;
+  }
+  else
+  {
+    /* A heavier tree edge competes for its place with the other edges
+     * across its cut. */
+    replaceTreeEdge (dyn, e, weight);
+  }
+  return true;
+}
+
+long long dynamicMSTWeight(DynamicMST* dyn)
+{
+  return dyn->totalWeight;
+}
+
+int dynamicMSTSize(DynamicMST* dyn)
+{
+  return dyn->numTreeEdges;
+}
+
+Edge* getDynamicMST(DynamicMST* dyn)
+{
+  Edge *tree = (Edge *) malloc (dyn->numTreeEdges * sizeof (Edge));
+  int count = 0;
+  for (int e = 0; e < dyn->numEdges; e++)
+    if (dyn->edges[e].inTree)
+    {
+      Edge edge = { dyn->edges[e].u, dyn->edges[e].v, dyn->edges[e].weight };
+      tree[count++] = edge;
+    }
+  return tree;
+}
+
+void deleteDynamicMST(DynamicMST* dyn)
+{
+  if (dyn == NULL)
+    return;
+  free (dyn->edges);
+  free (dyn->firstEdge);
+  free (dyn->table);
+  free (dyn->nodes);
+  free (dyn->splayStack);
+  for (int side = 0; side < 2; side++)
+  {
+    free (dyn->seen[side]);
+    free (dyn->queue[side]);
+  }
+  free (dyn);
+}
@@ -0,0 +1,92 @@
+/*
+ * Header file for our dynamic minimum spanning forest.
+ *
+ * A DynamicMST keeps the minimum spanning forest of an undirected graph
+ * correct while edges are inserted, deleted and reweighted, instead of
+ * rerunning getMSTprim after every change. The forest is held in a
+ * link-cut tree in which every tree edge is a node of its own, so the
+ * heaviest edge on the tree path between two vertices is found in
+ * O(log n) amortized time. That makes inserting an edge, lowering its
+ * weight, and changing a non-tree edge O(log n) amortized.
+ *
+ * Deleting a tree edge, or making it heavier, splits its tree in two. The
+ * lightest non-tree edge across the cut is then found by searching both
+ * halves in lockstep until the smaller one is exhausted, and scanning the
+ * edges of that half, so this costs time in the size of the smaller half
+ * rather than polylog time.
+ *
+ *   Edge *mst = getMSTprim (graph, 0);
+ *   DynamicMST *dyn = newDynamicMST (graph, mst, graph->numVertices - 1);
+ *   reweightMSTEdge (dyn, 3, 4, 17);
+ *   printf ("%lld\n", dynamicMSTWeight (dyn));
+ *   deleteDynamicMST (dyn);
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "graph.h"
+
+#ifndef __Dynamic_MST_header
+#define __Dynamic_MST_header
+
+typedef struct dynamic_mst DynamicMST;
+
+/*
+ * Returns a newly created DynamicMST for the undirected Graph 'graph',
+ * whose minimum spanning tree (or forest) is the array 'mst' of
+ * 'numTreeEdges' Edges, as returned by getMSTprim or getMSFboruvka. Edges
+ * of 'mst' with predecessor NOTHING are ignored. The edges of 'graph' are
+ * copied, so later changes go through the DynamicMST only; of parallel
+ * edges, the lightest one is kept. Self-loops are ignored.
+ * Precondition: 'graph' is undirected, i.e. every edge (u -- v, w) is
+ *               stored in both directions, and 'mst' is a minimum spanning
+ *               forest of 'graph'
+ */
+DynamicMST* newDynamicMST(Graph* graph, Edge* mst, int numTreeEdges);
+
+/*
+ * Inserts the edge (u -- v, weight) and returns true. Has no effect and
+ * returns false if u or v is not a valid vertex, u == v, weight < 0, or
+ * the edge exists already.
+ */
+bool insertMSTEdge(DynamicMST* dyn, int u, int v, dist_t weight);
+
+/*
+ * Deletes the edge (u -- v) and returns true. If it was a tree edge, the
+ * lightest edge that reconnects the two halves, if any, replaces it.
+ * Has no effect and returns false if the edge does not exist.
+ */
+bool deleteMSTEdge(DynamicMST* dyn, int u, int v);
+
+/*
+ * Sets the weight of the edge (u -- v) to 'weight' and returns true.
+ * Has no effect and returns false if the edge does not exist or
+ * weight < 0.
+ */
+bool reweightMSTEdge(DynamicMST* dyn, int u, int v, dist_t weight);
+
+/*
+ * Returns the total weight of the current minimum spanning forest.
+ */
+long long dynamicMSTWeight(DynamicMST* dyn);
+
+/*
+ * Returns the number of edges in the current minimum spanning forest:
+ * numVertices minus the number of connected components.
+ */
+int dynamicMSTSize(DynamicMST* dyn);
+
+/*
+ * Returns a newly created array of the dynamicMSTSize edges of the current
+ * minimum spanning forest, as (u -- v, weight) with u < v.
+ */
+Edge* getDynamicMST(DynamicMST* dyn);
+
+/*
+ * Frees all memory allocated for 'dyn'.
+ */
+void deleteDynamicMST(DynamicMST* dyn);
+
+#endif
@@ -0,0 +1,253 @@
+/*
+ * Our incremental single-source shortest paths.
+ *
+ * A batch is repaired in two steps. First, every vertex below a tree edge
+ * whose weight went up loses its distance: these invalid vertices are
+ * detached and queued with their best edge from a vertex that kept its
+ * distance. Second, the heads of edges whose weight went down are queued
+ * if the edge gives them a shorter distance. Dijkstra's algorithm from
+ * the queued vertices then settles only the invalid vertices and the
+ * vertices whose distance goes down.
+ */
+
+#include <string.h>
+
+#include "dynamic_sssp.h"
+#include "graph_algos.h"
+
+/*
+ * Makes vertex 'v' a child of 'parent' in the child lists of 'sssp'.
+ */
+static void linkChild(DynamicSSSP* sssp, int v, int parent)
+{
+  int first = sssp->firstChild[parent];
+  sssp->prevSibling[v] = NOTHING;
+  sssp->nextSibling[v] = first;
+  if (first != NOTHING)
+    sssp->prevSibling[first] = v;
+  sssp->firstChild[parent] = v;
+}
+
+/*
+ * Removes vertex 'v' from the child list of its tree predecessor, if it
+ * has one.
+ */
+static void unlinkChild(DynamicSSSP* sssp, int v)
+{
+  int parent = sssp->tree[v].toVertex;
+  if (parent == NOTHING || v == sssp->startVertex)
+    return;
+
+  int prev = sssp->prevSibling[v];
+  int next = sssp->nextSibling[v];
+  if (prev != NOTHING)
+    sssp->nextSibling[prev] = next;
+  else
+    sssp->firstChild[parent] = next;
+  if (next != NOTHING)
+    sssp->prevSibling[next] = prev;
+}
+
+DynamicSSSP* newDynamicSSSP(Graph* graph, Graph* reverse, Edge* tree,
+                            int startVertex)
+{
+  int n = graph->numVertices;
+  DynamicSSSP *sssp = (DynamicSSSP *) malloc (sizeof (DynamicSSSP));
+  sssp->graph = graph;
+  sssp->reverse = reverse;
+  sssp->tree = tree;
+  sssp->startVertex = startVertex;
+  sssp->firstChild = (int *) malloc (n * sizeof (int));
+  sssp->nextSibling = (int *) malloc (n * sizeof (int));
+  sssp->prevSibling = (int *) malloc (n * sizeof (int));
+  sssp->invalid = (unsigned *) calloc (n, sizeof (unsigned));
+  sssp->invalidList = (int *) malloc (n * sizeof (int));
+  sssp->numInvalidated = 0;
+  sssp->ws = newWorkspace (n);
+  sssp->numSettled = 0;
+
+  for (int id = 0; id < n; id++)
+    sssp->firstChild[id] = NOTHING;
+  for (int id = 0; id < n; id++)
+    if (id != startVertex && tree[id].toVertex != NOTHING)
+      linkChild (sssp, id, tree[id].toVertex);
+  return sssp;
+}
+
+/*
+ * Returns an edge from 'fromVertex' to 'toVertex' in 'graph', or NULL if
+ * there is none.
+ */
+static Edge* findEdge(Graph* graph, int fromVertex, int toVertex)
+{
+  for (EdgeList *l = graph->vertices[fromVertex]->adjList; l != NULL;
+       l = l->next)
+    if (l->edge->toVertex == toVertex)
+      return l->edge;
+  return NULL;
+}
+
+/*
+ * Sets the weight of every edge 'fromVertex' -> 'toVertex' in 'graph' to
+ * 'weight', inserting one if there is none. Returns the smallest old weight
+ * of these edges, or NOTHING if the edge was inserted.
+ */
+static dist_t setEdgeWeight(Graph* graph, int fromVertex, int toVertex,
+                            dist_t weight)
+{
+  Vertex *from = graph->vertices[fromVertex];
+  dist_t old = NOTHING;
+  for (EdgeList *l = from->adjList; l != NULL; l = l->next)
+    if (l->edge->toVertex == toVertex)
+    {
+      if (old == NOTHING || l->edge->weight < old)
+        old = l->edge->weight;
+      l->edge->weight = weight;
+    }
+  if (old != NOTHING)
+    return old;
+
+  Edge *edge = graphNewEdge (graph, fromVertex, toVertex, weight);
+  from->adjList = graphNewEdgeList (graph, edge, from->adjList);
+  graph->numEdges++;
+  return NOTHING;
+}
+
+/*
+ * Marks 'root' and all its descendants in the tree of 'sssp' invalid and
+ * appends them to sssp->invalidList, skipping vertices that are invalid
+ * already.
+ */
+static void invalidateSubtree(DynamicSSSP* sssp, int root)
+{
+  unsigned epoch = sssp->ws->epoch;
+  if (sssp->invalid[root] == epoch)
+    return;
+
+  int next = sssp->numInvalidated;
+  sssp->invalid[root] = epoch;
+  sssp->invalidList[sssp->numInvalidated++] = root;
+  for (; next < sssp->numInvalidated; next++)
+    for (int c = sssp->firstChild[sssp->invalidList[next]]; c != NOTHING;
+         c = sssp->nextSibling[c])
+      if (sssp->invalid[c] != epoch)
+      {
+        sssp->invalid[c] = epoch;
+        sssp->invalidList[sssp->numInvalidated++] = c;
+      }
+}
+
+/*
+ * Queues vertex 'v' with 'distance' via 'predecessor' if that is shorter
+ * than its distance in the tree and its tentative distance.
+ */
+static void relaxVertex(DynamicSSSP* sssp, int v, dist_t distance,
+                        int predecessor)
+{
+  if (distance < sssp->tree[v].weight)
+    wsRelax (sssp->ws, v, distance, predecessor);
+}
+
+int updateDistanceTree(DynamicSSSP* sssp, EdgeUpdate* updates,
+                       int numUpdates)
+{
+  int n = sssp->graph->numVertices;
+  Edge *tree = sssp->tree;
+  Workspace *ws = sssp->ws;
+
+  resetWorkspace (ws);
+  if (ws->epoch == 1)
+  {
+    /* The stamps of 'ws' wrapped around; clear ours as well. */
+    memset (sssp->invalid, 0, n * sizeof (unsigned));
+  }
+  sssp->numInvalidated = 0;
+  sssp->numSettled = 0;
+
+  /* Change the graphs. The tree is still the old one, so an increased
+   * tree edge tells which subtree loses its distances. */
+  for (int i = 0; i < numUpdates; i++)
+  {
+    int u = updates[i].fromVertex;
+    int v = updates[i].toVertex;
+    dist_t weight = updates[i].weight;
+    if (u < 0 || u >= n || v < 0 || v >= n || weight < 0)
+      continue;
+
+    dist_t old = setEdgeWeight (sssp->graph, u, v, weight);
+    if (sssp->reverse)
+      setEdgeWeight (sssp->reverse, v, u, weight);
+    if (old != NOTHING && weight > old && v != sssp->startVertex
+        && tree[v].toVertex == u)
+      invalidateSubtree (sssp, v);
+  }
+
+  /* Detach the invalid vertices first, while their predecessors are still
+   * known, then forget their distances. */
+  for (int k = 0; k < sssp->numInvalidated; k++)
+    unlinkChild (sssp, sssp->invalidList[k]);
+  for (int k = 0; k < sssp->numInvalidated; k++)
+  {
+    int v = sssp->invalidList[k];
+    tree[v].toVertex = NOTHING;
+    tree[v].weight = DIST_MAX;
+  }
+
+  /* Queue every invalid vertex with its best edge from a vertex that kept
+   * its distance. */
+  Graph *in = sssp->reverse ? sssp->reverse : sssp->graph;
+  for (int k = 0; k < sssp->numInvalidated; k++)
+  {
+    int v = sssp->invalidList[k];
+    for (EdgeList *l = in->vertices[v]->adjList; l != NULL; l = l->next)
+    {
+      int u = l->edge->toVertex;
+      if (tree[u].weight != DIST_MAX)
+        relaxVertex (sssp, v, distAdd (tree[u].weight, l->edge->weight), u);
+    }
+  }
+
+  /* Queue the heads of decreased and inserted edges. An edge may change
+   * more than once in a batch, so its final weight is looked up. */
+  for (int i = 0; i < numUpdates; i++)
+  {
+    int u = updates[i].fromVertex;
+    int v = updates[i].toVertex;
+    if (u < 0 || u >= n || v < 0 || v >= n || updates[i].weight < 0
+        || tree[u].weight == DIST_MAX)
+      continue;
+    Edge *edge = findEdge (sssp->graph, u, v);
+    relaxVertex (sssp, v, distAdd (tree[u].weight, edge->weight), u);
+  }
+
+  /* Dijkstra's algorithm from the queued vertices. */
+  while (ws->heap->size > 0)
+  {
+    HeapNode u = wsSettleNext (ws);
+    int parent = ws->predecessors[u.id];
+    unlinkChild (sssp, u.id);
+    tree[u.id].toVertex = parent;
+    tree[u.id].weight = u.priority;
+    linkChild (sssp, u.id, parent);
+    sssp->numSettled++;
+
+    for (EdgeList *l = sssp->graph->vertices[u.id]->adjList; l != NULL;
+         l = l->next)
+      relaxVertex (sssp, l->edge->toVertex,
+                   distAdd (u.priority, l->edge->weight), u.id);
+  }
+  return sssp->numSettled;
+}
+
+void deleteDynamicSSSP(DynamicSSSP* sssp)
+{
+  if (sssp == NULL)
+    return;
+  free (sssp->firstChild);
+  free (sssp->nextSibling);
+  free (sssp->prevSibling);
+  free (sssp->invalid);
+  free (sssp->invalidList);
+  deleteWorkspace (sssp->ws);
+  free (sssp);
+}
@@ -0,0 +1,82 @@
+/*
+ * Header file for our incremental single-source shortest paths.
+ *
+ * A DynamicSSSP keeps a distance tree of getDistanceTreeDijkstra correct
+ * while edge weights change, in the style of Ramalingam and Reps: after a
+ * batch of updates only the vertices whose distance or tree edge can have
+ * changed are repaired, instead of rerunning Dijkstra's algorithm.
+ *
+ *   Edge *tree = getDistanceTreeDijkstra (graph, 0);
+ *   DynamicSSSP *sssp = newDynamicSSSP (graph, NULL, tree, 0);
+ *   EdgeUpdate batch[] = {{3, 4, 17}, {4, 3, 17}};
+ *   updateDistanceTree (sssp, batch, 2);   // 'tree' is up to date again
+ *   deleteDynamicSSSP (sssp);
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "graph.h"
+#include "workspace.h"
+
+#ifndef __Dynamic_SSSP_header
+#define __Dynamic_SSSP_header
+
+typedef struct edge_update {
+  int fromVertex;   // the edge fromVertex -> toVertex; it is inserted if
+  int toVertex;     //   the graph has no such edge yet
+  dist_t weight;    // new weight of the edge; weight >= 0
+} EdgeUpdate;
+
+typedef struct dynamic_sssp {
+  Graph* graph;         // the graph, changed by every batch
+  Graph* reverse;       // the reverse of 'graph', or NULL if undirected
+  Edge* tree;           // the distance tree being maintained
+  int startVertex;      // the root of 'tree'
+  int* firstChild;      // firstChild[id] is a child of id in 'tree', or
+                        //   NOTHING; the children of id are linked by
+  int* nextSibling;     //   nextSibling and prevSibling
+  int* prevSibling;
+  unsigned* invalid;    // invalid[id] == ws->epoch iff id lost its tree
+                        //   path in the current batch
+  int* invalidList;     // the invalid vertices of the current batch
+  int numInvalidated;   // number of entries in 'invalidList'
+  Workspace* ws;        // the priority queue of the repair
+  int numSettled;       // vertices the last batch gave a new tree edge
+} DynamicSSSP;
+
+/*
+ * Returns a newly created DynamicSSSP that maintains the distance tree
+ * 'tree' from 'startVertex' of Graph 'graph'. 'reverse' is the reverse of
+ * 'graph' (see newReverseGraph), or NULL if 'graph' is undirected. Both
+ * graphs and 'tree' stay owned by the caller, and are changed in place by
+ * updateDistanceTree.
+ * Precondition: 'tree' was returned by getDistanceTreeDijkstra (or one of
+ *               its variants) for 'graph' and 'startVertex'
+ */
+DynamicSSSP* newDynamicSSSP(Graph* graph, Graph* reverse, Edge* tree,
+                            int startVertex);
+
+/*
+ * Sets the weight of the edge u -> v to w for every update (u, v, w) of the
+ * 'numUpdates' updates in 'updates', in order, inserting the edge if
+ * 'graph' has none (if it has several, all of them change). The same
+ * changes are made to 'reverse'. Then repairs the tree
+ * of 'sssp' in place, keeping the layout of getDistanceTreeDijkstra:
+ * tree[id] is (id -- predecessor, distance), and (id -- NOTHING, DIST_MAX)
+ * if id is unreachable.
+ * Updates with an invalid vertex or a negative weight are skipped.
+ * Returns the number of vertices that got a new tree edge.
+ * Precondition: for an undirected graph, every update comes with the
+ *               update of the opposite direction
+ */
+int updateDistanceTree(DynamicSSSP* sssp, EdgeUpdate* updates,
+                       int numUpdates);
+
+/*
+ * Frees all memory allocated for 'sssp', but not its graphs and tree.
+ */
+void deleteDynamicSSSP(DynamicSSSP* sssp);
+
+#endif
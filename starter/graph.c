@@ -1,127 +1,208 @@
-/*
- * Our graph implementation.
- *
- * Author: Akshay Arun Bapat
- * Based on implementation from A. Tafliovich
- */
-
-#include "graph.h"
-
-/*********************************************************************
- ** Helper function provided in the starter code
- *********************************************************************/
-
-void printEdge(Edge* edge)
-{
-  if (edge == NULL)
-    printf("NULL");
-  else
-    printf("(%d -- %d, %d)", edge->fromVertex, edge->toVertex, edge->weight);
-}
-
-void printEdgeList(EdgeList* head)
-{
-  while (head != NULL)
-  {
-    printEdge(head->edge);
-    printf(" --> ");
-    head = head->next;
-  }
-  printf("NULL");
-}
-
-void printVertex(Vertex* vertex)
-{
-  if (vertex == NULL)
-  {
-    printf("NULL");
-  }
-  else
-  {
-    printf("%d: ", vertex->id);
-    printEdgeList(vertex->adjList);
-  }
-}
-
-void printGraph(Graph* graph)
-{
-  if (graph == NULL)
-  {
-    printf("NULL");
-    return;
-  }
-  printf("Number of vertices: %d. Number of edges: %d.\n\n", graph->numVertices,
-         graph->numEdges);
-
-  for (int i = 0; i < graph->numVertices; i++)
-  {
-    printVertex(graph->vertices[i]);
-    printf("\n");
-  }
-  printf("\n");
-}
-
-/*********************************************************************
- ** Required functions
- *********************************************************************/
-
-Edge* newEdge(int fromVertex, int toVertex, int weight)
-{
-  Edge *edge = (Edge *) malloc (sizeof (Edge));
-  edge->fromVertex = fromVertex;
-  edge->toVertex = toVertex;
-  edge->weight = weight;
-  return edge;
-}
-
-EdgeList* newEdgeList(Edge* edge, EdgeList* next)
-{
-  EdgeList *list = (EdgeList *) malloc (sizeof (EdgeList));
-  list->edge = edge;
-  list->next = next;
-  return list;
-}
-
-Vertex* newVertex(int id, void* value, EdgeList* adjList)
-{
-  Vertex *vertex = (Vertex *) malloc (sizeof (Vertex));
-  vertex->id = id;
-  vertex->value = value;
-  vertex->adjList = adjList;
-  return vertex;
-}
-
-Graph* newGraph(int numVertices)
-{
-  Graph *graph = (Graph *) malloc (sizeof (Graph));
-  graph->numVertices = numVertices;
-  graph->numEdges = 0;
-  graph->vertices = (Vertex **) malloc (numVertices * sizeof (Vertex *));
-  return graph;
-}
-
-void deleteEdgeList(EdgeList* head)
-{
-  EdgeList *nxt = NULL;
-  while (head)
-  {
-    nxt = head->next;
-    free (head->edge);
-    free (head);
-    head = nxt;
-  }
-}
-
-void deleteVertex(Vertex* vertex)
-{
-  deleteEdgeList (vertex->adjList);
-  free (vertex);
-}
-
-void deleteGraph(Graph* graph)
-{
-  for (int i = 0; i < graph->numVertices; i++)
-    deleteVertex (graph->vertices[i]);
-  free (graph->vertices);
-  free (graph);
-}
+/*
+ * Our graph implementation.
+ *
+ * Author: Akshay Arun Bapat
+ * Based on implementation from A. Tafliovich
+ */
+
+#include "graph.h"
+
+/*********************************************************************
+ ** Helper function provided in the starter code
+ *********************************************************************/
+
+void printEdge(Edge* edge)
+{
+  if (edge == NULL)
+    printf("NULL");
+  else
+    printf("(%d -- %d, %" PRIdist ")", edge->fromVertex, edge->toVertex, edge->weight);
+}
+
+void printEdgeList(EdgeList* head)
+{
+  while (head != NULL)
+  {
+    printEdge(head->edge);
+    printf(" --> ");
+    head = head->next;
+  }
+  printf("NULL");
+}
+
+void printVertex(Vertex* vertex)
+{
+  if (vertex == NULL)
+  {
+    printf("NULL");
+  }
+  else
+  {
+    printf("%d: ", vertex->id);
+    printEdgeList(vertex->adjList);
+  }
+}
+
+void printGraph(Graph* graph)
+{
+  if (graph == NULL)
+  {
+    printf("NULL");
+    return;
+  }
+  printf("Number of vertices: %d. Number of edges: %d.\n\n", graph->numVertices,
+         graph->numEdges);
+
+  for (int i = 0; i < graph->numVertices; i++)
+  {
+    printVertex(graph->vertices[i]);
+    printf("\n");
+  }
+  printf("\n");
+}
+
+/*********************************************************************
+ ** Required functions
+ *********************************************************************/
+
+Edge* newEdge(int fromVertex, int toVertex, dist_t weight)
+{
+  Edge *edge = (Edge *) malloc (sizeof (Edge));
+  edge->fromVertex = fromVertex;
+  edge->toVertex = toVertex;
+  edge->weight = weight;
+  return edge;
+}
+
+EdgeList* newEdgeList(Edge* edge, EdgeList* next)
+{
+  EdgeList *list = (EdgeList *) malloc (sizeof (EdgeList));
+  list->edge = edge;
+  list->next = next;
+  return list;
+}
+
+Vertex* newVertex(int id, void* value, EdgeList* adjList)
+{
+  Vertex *vertex = (Vertex *) malloc (sizeof (Vertex));
+  vertex->id = id;
+  vertex->value = value;
+  vertex->adjList = adjList;
+  return vertex;
+}
+
+Graph* newGraph(int numVertices)
+{
+  Graph *graph = (Graph *) malloc (sizeof (Graph));
+  graph->numVertices = numVertices;
+  graph->numEdges = 0;
+  graph->vertices = (Vertex **) malloc (numVertices * sizeof (Vertex *));
+  graph->arena = NULL;
+  return graph;
+}
+
+Graph* newArenaGraph(int numVertices, int numEdgesHint)
+{
+  Graph *graph = newGraph (numVertices);
+
+  /* One slab is enough when the number of edges is known up front. */
+  size_t slabSize = (size_t) numEdgesHint * (sizeof (Edge) + sizeof (EdgeList))
+                    + (size_t) numVertices * sizeof (Vertex);
+  if (numEdgesHint == 0 || slabSize < ARENA_DEFAULT_SLAB_SIZE)
+    slabSize = ARENA_DEFAULT_SLAB_SIZE;
+  graph->arena = newArena (slabSize);
+  return graph;
+}
+
+Edge* graphNewEdge(Graph* graph, int fromVertex, int toVertex,
+                   dist_t weight)
+{
+  if (graph->arena == NULL)
+    return newEdge (fromVertex, toVertex, weight);
+
+  Edge *edge = (Edge *) arenaAlloc (graph->arena, sizeof (Edge),
+                                    _Alignof (Edge));
+  if (edge == NULL)
+    return NULL;
+  edge->fromVertex = fromVertex;
+  edge->toVertex = toVertex;
+  edge->weight = weight;
+  return edge;
+}
+
+EdgeList* graphNewEdgeList(Graph* graph, Edge* edge, EdgeList* next)
+{
+  if (graph->arena == NULL)
+    return newEdgeList (edge, next);
+
+  EdgeList *list = (EdgeList *) arenaAlloc (graph->arena, sizeof (EdgeList),
+                                            _Alignof (EdgeList));
+  if (list == NULL)
+    return NULL;
+  list->edge = edge;
+  list->next = next;
+  return list;
+}
+
+Vertex* graphNewVertex(Graph* graph, int id, void* value, EdgeList* adjList)
+{
+  if (graph->arena == NULL)
+    return newVertex (id, value, adjList);
+
+  Vertex *vertex = (Vertex *) arenaAlloc (graph->arena, sizeof (Vertex),
+                                          _Alignof (Vertex));
+  if (vertex == NULL)
+    return NULL;
+  vertex->id = id;
+  vertex->value = value;
+  vertex->adjList = adjList;
+  return vertex;
+}
+
+Graph* newReverseGraph(Graph* graph)
+{
+  Graph *reverse = newArenaGraph (graph->numVertices, graph->numEdges);
+  for (int i = 0; i < graph->numVertices; i++)
+    reverse->vertices[i] = graphNewVertex (reverse, i, graph->vertices[i]->value,
+                                           NULL);
+
+  for (int i = 0; i < graph->numVertices; i++)
+    for (EdgeList *l = graph->vertices[i]->adjList; l != NULL; l = l->next)
+    {
+      Vertex *to = reverse->vertices[l->edge->toVertex];
+      Edge *edge = graphNewEdge (reverse, to->id, i, l->edge->weight);
+      to->adjList = graphNewEdgeList (reverse, edge, to->adjList);
+      reverse->numEdges++;
+    }
+  return reverse;
+}
+
+void deleteEdgeList(EdgeList* head)
+{
+  EdgeList *nxt = NULL;
+  while (head)
+  {
+    nxt = head->next;
+    free (head->edge);
+    free (head);
+    head = nxt;
+  }
+}
+
+void deleteVertex(Vertex* vertex)
+{
+  deleteEdgeList (vertex->adjList);
+  free (vertex);
+}
+
+void deleteGraph(Graph* graph)
+{
+  if (graph->arena != NULL)
+    deleteArena (graph->arena);
+  else
+    for (int i = 0; i < graph->numVertices; i++)
+      if (graph->vertices[i] != NULL)
+        deleteVertex (graph->vertices[i]);
+  free (graph->vertices);
+  free (graph);
+}
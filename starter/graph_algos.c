@@ -1,300 +1,722 @@
-/*
- * Graph algorithms.
- *
- * Author: Akshay Arun Bapat
- * Based on implementation from A. Tafliovich
- */
-
-#include <limits.h>
-#include <string.h>
-
-#include "graph.h"
-#include "minheap.h"
-
-MinHeap* initHeap(Graph* graph, int startVertex);
-
-/*
- * A structure to keep record of the current running algorithm.
- */
-typedef struct records
-{
-  int numVertices;    // total number of vertices in the graph
-                      // vertex IDs are 0, 1, ..., numVertices-1
-  MinHeap* heap;      // priority queue
-  bool* finished;     // finished[id] is true iff vertex id is finished
-                      //   i.e. no longer in the PQ
-  int* predecessors;  // predecessors[id] is the predecessor of vertex id
-  int* distances;     // distances[id] is distance(start, id) in Dijkstra's.
-  Edge* tree;         // keeps edges for the resulting tree
-  int numTreeEdges;   // current number of edges in mst
-} Records;
-
-/*************************************************************************
- ** Suggested helper functions -- part of starter code
- *************************************************************************/
-
-/*
- * Creates, populates, and returns all records needed to run Prim's and
- * Dijkstra's algorithms on Graph 'graph' starting from vertex with ID
- * 'startVertex'.
- * Precondition: 'startVertex' is valid in 'graph'
- */
-Records* initRecords(Graph* graph, int startVertex)
-{
-  Records *records = (Records *) malloc (sizeof (Records));
-
-  records->numVertices = graph->numVertices;
-  records->heap = initHeap(graph, startVertex);
-
-  // allocates and initializes all entries to false.
-  records->finished = (bool *) calloc (graph->numVertices, sizeof (bool));
-
-  records->predecessors = (int *) malloc (graph->numVertices * sizeof (int));
-  records->distances = (int *) malloc (graph->numVertices * sizeof (int));
-  records->tree = (Edge *) malloc (graph->numVertices * sizeof (Edge));
-  records->numTreeEdges = 0;
-
-  return records;
-}
-
-/*
- * Creates, populates, and returns a MinHeap to be used by Prim's and
- * Dijkstra's algorithms on Graph 'graph' starting from vertex with ID
- * 'startVertex'.
- * Precondition: 'startVertex' is valid in 'graph'
- */
-MinHeap* initHeap(Graph* graph, int startVertex)
-{
-  MinHeap *min_heap = newHeap (graph->numVertices);
-
-  insert (min_heap, 0, startVertex);
-
-  for (int id = 0; id < graph->numVertices; id++)
-    if (id != startVertex)
-      insert (min_heap, INT_MAX, id);
-  
-  return min_heap; 
-}
-
-/* Allocates and populates  an array of edges of 'size' length with the
-contents of edge array 'arr_' . */
-Edge* newEdgeArr(int size, Edge* arr_)
-{
-  Edge *arr = (Edge *) malloc (size * sizeof (Edge));
-  memcpy (arr, arr_, size * sizeof (Edge));
-}
-
-/* Frees entire record structure given by 'rec' except the tree field. */
-void deleteRecords(Records *rec)
-{
-  deleteHeap (rec->heap);
-  free (rec->finished);
-  free (rec->predecessors);
-  free (rec->distances);
-  free (rec->tree);
-  free(rec);
-}
-
-/*
- * Returns true iff 'heap' is NULL or is empty.
- */
-bool isEmpty(MinHeap* heap)
-{
-  return heap == NULL || heap->size == 0;
-}
-
-/*
- * Prints the status of all current algorithm data: good for debugging.
- */
-void printRecords(Records* records);
-
-/*
- * Add a new edge to records at index ind.
- */
-void addTreeEdge(Records* records, int ind, int fromVertex, int toVertex,
-                 int weight)
-{
-  Edge edge = {fromVertex, toVertex, weight};
-  records->tree[ind] = edge;
-  records->numTreeEdges++;
-}
-
-/*
- * Creates and returns a path from 'vertex' to 'startVertex' from edges
- * in the distance tree 'distTree'.
- */
-EdgeList* makePath(Edge* distTree, int vertex, int startVertex)
-{
-  Edge *edge = &distTree[vertex];
-  Edge* tmpEdge;
-  EdgeList *list, *start, *prev, *tmp;
-
-  /* Temporary first node of edge list. Will be freed after first iteration. */
-  prev = newEdgeList (NULL, NULL);
-
-  /* Add the path to list. Path is unique and terminates at startVertex. */
-  while (edge->fromVertex != startVertex)
-  {
-    tmpEdge = newEdge (edge->fromVertex, edge->toVertex, edge->weight);
-    list = newEdgeList (tmpEdge, NULL);
-    prev->next = list;
-
-    if (prev->edge)
-      prev->edge->weight -= edge->weight;
-    
-    /* Record start node of list. */
-    if (edge->fromVertex == vertex)
-    {
-      start = prev->next;
-      tmp = prev;
-    }
-
-    list = list->next;
-    prev = prev->next;
-
-    /* Free the first node of prev as it is null. */
-    if (edge->fromVertex == vertex)
-      free (tmp);
-
-    edge = &distTree[edge->toVertex];
-  }
-
-  return start;
-}
-
-/* Returns true iff id is a valid id in the graph 'graph'. */
-bool isValidNode(Graph* graph, int id)
-{
-  return 0 <= id && id < graph->numVertices;
-}
-
-/*************************************************************************
- ** Required functions
- *************************************************************************/
-
-Edge* getMSTprim(Graph* graph, int startVertex)
-{
-  if (!isValidNode (graph, startVertex))
-    return NULL;
-
-  Records *rec = initRecords(graph, startVertex);
-
-  while (!isEmpty (rec->heap))
-  {
-    HeapNode u = extractMin (rec->heap);
-    rec->finished[u.id] = true;
-
-    /* Omit adding the start node, because it doesn't have a predecessor. */
-    if (u.id != startVertex)
-      addTreeEdge (rec, rec->numTreeEdges, u.id, rec->predecessors[u.id], u.priority);
-
-    /* Iterate through u's adjacency list. */
-    EdgeList* l = graph->vertices[u.id]->adjList;
-    while (l != NULL)
-    {
-      Vertex *v = graph->vertices[l->edge->toVertex];
-      /* If v in heap and w(u, v) less than priority(v) . */
-      if (rec->finished[v->id] == false && 
-          l->edge->weight < getPriority (rec->heap, v->id))
-      {
-        decreasePriority(rec->heap, v->id, l->edge->weight);
-        rec->predecessors[v->id] = u.id; 
-      }
-      l = l->next;
-    }
-  }
-  
-  Edge *res_tree = newEdgeArr(rec->numTreeEdges, rec->tree);
-  deleteRecords (rec);
-
-  return res_tree;
-}
-
-Edge* getDistanceTreeDijkstra(Graph* graph, int startVertex)
-{
-  if (!isValidNode (graph, startVertex))
-    return NULL;
-
-  Records* rec = initRecords(graph, startVertex);
-  rec->distances[startVertex] = 0;
-
-  while (!isEmpty (rec->heap))
-  {
-    HeapNode u = extractMin (rec->heap);
-    rec->finished[u.id] = true;
-    
-    /* Iterate through u's adjacency list. */
-    EdgeList* l = graph->vertices[u.id]->adjList;
-    while (l != NULL)
-    {
-      Vertex* v = graph->vertices[l->edge->toVertex];
-      int new_dist = getPriority (rec->heap, u.id) + l->edge->weight;
-      /* If v in heap and dist(start, v) less than priority(v) . */
-      if (rec->finished[v->id] == false && new_dist < getPriority(rec->heap, v->id))
-      {
-        decreasePriority(rec->heap, v->id, new_dist);
-        rec->distances[v->id] = new_dist;
-        rec->predecessors[v->id] = u.id; 
-      }
-      l = l->next;
-    }
-  }
-
-  /* Build Distance Tree */
-  addTreeEdge (rec, startVertex, startVertex, startVertex, 0);
-  for (int id = 0; id < graph->numVertices; id++)
-    if (id != startVertex)
-      addTreeEdge (rec, id, id, rec->predecessors[id], rec->distances[id]);
-
-  Edge *res_tree = newEdgeArr(rec->numTreeEdges, rec->tree);
-  deleteRecords (rec);
-
-  return res_tree;
-}
-
-EdgeList** getShortestPaths(Edge* distTree, int numVertices, int startVertex)
-{
-  if (!(0 <= startVertex && startVertex < numVertices))
-    return NULL;
-  
-  EdgeList **paths = (EdgeList **) malloc (numVertices * sizeof (EdgeList *));
-  paths[startVertex] = NULL;
-
-  for (int id = 0; id < numVertices; id++)
-  {
-    if (id == startVertex)
-      continue;
-
-    paths[id] = makePath (distTree, id, startVertex);
-  }
-
-  return paths;
-}
-
-/*************************************************************************
- ** Provided helper functions -- part of starter code to help you debug!
- *************************************************************************/
-void printRecords(Records* records)
-{
-  if (records == NULL)
-    return;
-
-  int numVertices = records->numVertices;
-  printf("Reporting on algorithm's records on %d vertices...\n", numVertices);
-
-  printf("The PQ is:\n");
-  printHeap(records->heap);
-
-  printf("The finished array is:\n");
-  for (int i = 0; i < numVertices; i++)
-    printf("\t%d: %d\n", i, records->finished[i]);
-
-  printf("The predecessors array is:\n");
-  for (int i = 0; i < numVertices; i++)
-    printf("\t%d: %d\n", i, records->predecessors[i]);
-
-  printf("The TREE edges are:\n");
-  for (int i = 0; i < records->numTreeEdges; i++) printEdge(&records->tree[i]);
-
-  printf("... done.\n");
-}
+/*
+ * Graph algorithms.
+ *
+ * Author: Akshay Arun Bapat
+ * Based on implementation from A. Tafliovich
+ */
+
+#include <limits.h>
+#include <string.h>
+
+#include "algo_stats.h"
+#include "bucketqueue.h"
+#include "csr.h"
+#include "graph.h"
+#include "graph_algos.h"
+#include "minheap.h"
+#include "workspace.h"
+
+MinHeap* newStartHeap(int numVertices, int startVertex);
+
+/*
+ * A structure to keep record of the current running algorithm.
+ */
+typedef struct records
+{
+  int numVertices;    // total number of vertices in the graph
+                      // vertex IDs are 0, 1, ..., numVertices-1
+  MinHeap* heap;      // priority queue
+  bool* finished;     // finished[id] is true iff vertex id is finished
+                      //   i.e. no longer in the PQ
+  int* predecessors;  // predecessors[id] is the predecessor of vertex id
+  dist_t* distances;  // distances[id] is distance(start, id) in Dijkstra's.
+  Edge* tree;         // keeps edges for the resulting tree
+  int numTreeEdges;   // current number of edges in mst
+} Records;
+
+/*************************************************************************
+ ** Suggested helper functions -- part of starter code
+ *************************************************************************/
+
+/*
+ * Creates and returns records for a graph with 'numVertices' vertices,
+ * without a priority queue.
+ */
+Records* allocRecords(int numVertices)
+{
+  Records *records = (Records *) malloc (sizeof (Records));
+
+  records->numVertices = numVertices;
+  records->heap = NULL;
+
+  // allocates and initializes all entries to false.
+  records->finished = (bool *) calloc (numVertices, sizeof (bool));
+
+  records->predecessors = (int *) malloc (numVertices * sizeof (int));
+  records->distances = (dist_t *) malloc (numVertices * sizeof (dist_t));
+  records->tree = (Edge *) malloc (numVertices * sizeof (Edge));
+  records->numTreeEdges = 0;
+
+  return records;
+}
+
+/*
+ * Creates, populates, and returns all records needed to run Prim's and
+ * Dijkstra's algorithms on a graph with 'numVertices' vertices starting from
+ * vertex with ID 'startVertex'. Vertices that are never reached keep the
+ * predecessor NOTHING and the distance DIST_MAX.
+ * Precondition: 0 <= startVertex < numVertices
+ */
+Records* newRecords(int numVertices, int startVertex)
+{
+  Records *records = allocRecords(numVertices);
+  for (int id = 0; id < numVertices; id++)
+  {
+    records->predecessors[id] = NOTHING;
+    records->distances[id] = DIST_MAX;
+  }
+  records->heap = newStartHeap(numVertices, startVertex);
+  return records;
+}
+
+/*
+ * Creates, populates, and returns all records needed to run Prim's and
+ * Dijkstra's algorithms on Graph 'graph' starting from vertex with ID
+ * 'startVertex'.
+ * Precondition: 'startVertex' is valid in 'graph'
+ */
+Records* initRecords(Graph* graph, int startVertex)
+{
+  return newRecords(graph->numVertices, startVertex);
+}
+
+/*
+ * Creates, populates, and returns a MinHeap holding all 'numVertices'
+ * vertices, with priority 0 for 'startVertex' and DIST_MAX for the others.
+ * Precondition: 0 <= startVertex < numVertices
+ */
+MinHeap* newStartHeap(int numVertices, int startVertex)
+{
+  MinHeap *min_heap = newHeap (numVertices);
+
+  insert (min_heap, 0, startVertex);
+
+  for (int id = 0; id < numVertices; id++)
+    if (id != startVertex)
+      insert (min_heap, DIST_MAX, id);
+  
+  return min_heap; 
+}
+
+/*
+ * Creates, populates, and returns a MinHeap to be used by Prim's and
+ * Dijkstra's algorithms on Graph 'graph' starting from vertex with ID
+ * 'startVertex'.
+ * Precondition: 'startVertex' is valid in 'graph'
+ */
+MinHeap* initHeap(Graph* graph, int startVertex)
+{
+  return newStartHeap(graph->numVertices, startVertex);
+}
+
+/* Allocates and populates  an array of edges of 'size' length with the
+contents of edge array 'arr_' . */
+Edge* newEdgeArr(int size, Edge* arr_)
+{
+  Edge *arr = (Edge *) malloc (size * sizeof (Edge));
+  memcpy (arr, arr_, size * sizeof (Edge));
+  return arr;
+}
+
+/* Frees entire record structure given by 'rec' except the tree field. */
+void deleteRecords(Records *rec)
+{
+  if (rec->heap)
+    deleteHeap (rec->heap);
+  free (rec->finished);
+  free (rec->predecessors);
+  free (rec->distances);
+  free (rec->tree);
+  free(rec);
+}
+
+/*
+ * Returns true iff 'heap' is NULL or is empty.
+ */
+bool isEmpty(MinHeap* heap)
+{
+  return heap == NULL || heap->size == 0;
+}
+
+/*
+ * Prints the status of all current algorithm data: good for debugging.
+ */
+void printRecords(Records* records);
+
+/*
+ * Add a new edge to records at index ind.
+ */
+void addTreeEdge(Records* records, int ind, int fromVertex, int toVertex,
+                 dist_t weight)
+{
+  Edge edge = {fromVertex, toVertex, weight};
+  records->tree[ind] = edge;
+  records->numTreeEdges++;
+}
+
+/*
+ * Creates and returns a path from 'vertex' to 'startVertex' from edges
+ * in the distance tree 'distTree'.
+ */
+EdgeList* makePath(Edge* distTree, int vertex, int startVertex)
+{
+  Edge *edge = &distTree[vertex];
+  Edge* tmpEdge;
+  EdgeList *list, *start, *prev, *tmp;
+
+  /* Temporary first node of edge list. Will be freed after first iteration. */
+  prev = newEdgeList (NULL, NULL);
+
+  /* Add the path to list. Path is unique and terminates at startVertex. */
+  while (edge->fromVertex != startVertex)
+  {
+    tmpEdge = newEdge (edge->fromVertex, edge->toVertex, edge->weight);
+    list = newEdgeList (tmpEdge, NULL);
+    prev->next = list;
+
+    if (prev->edge)
+      prev->edge->weight -= edge->weight;
+    
+    /* Record start node of list. */
+    if (edge->fromVertex == vertex)
+    {
+      start = prev->next;
+      tmp = prev;
+    }
+
+    list = list->next;
+    prev = prev->next;
+
+    /* Free the first node of prev as it is null. */
+    if (edge->fromVertex == vertex)
+      free (tmp);
+
+    edge = &distTree[edge->toVertex];
+  }
+
+  return start;
+}
+
+/*
+ * Builds the distance tree from the predecessors and distances in 'rec' of a
+ * finished run of Dijkstra's algorithm from 'startVertex', frees 'rec', and
+ * returns the tree.
+ */
+Edge* buildDistanceTree(Records* rec, int startVertex)
+{
+  addTreeEdge (rec, startVertex, startVertex, startVertex, 0);
+  for (int id = 0; id < rec->numVertices; id++)
+    if (id != startVertex)
+      addTreeEdge (rec, id, id, rec->predecessors[id], rec->distances[id]);
+
+  Edge *res_tree = newEdgeArr(rec->numTreeEdges, rec->tree);
+  deleteRecords (rec);
+
+  return res_tree;
+}
+
+/* Returns true iff id is a valid id in the graph 'graph'. */
+bool isValidNode(Graph* graph, int id)
+{
+  return 0 <= id && id < graph->numVertices;
+}
+
+/* Returns the largest edge weight in 'graph', or 0 if it has no edges. */
+dist_t maxEdgeWeight(Graph* graph)
+{
+  dist_t maxWeight = 0;
+  for (int id = 0; id < graph->numVertices; id++)
+    for (EdgeList *l = graph->vertices[id]->adjList; l != NULL; l = l->next)
+      if (l->edge->weight > maxWeight)
+        maxWeight = l->edge->weight;
+  return maxWeight;
+}
+
+/*************************************************************************
+ ** Required functions
+ *************************************************************************/
+
+Edge* getMSTprim(Graph* graph, int startVertex)
+{
+  if (!isValidNode (graph, startVertex))
+    return NULL;
+
+  STATS_TIMER(timer);
+  Records *rec = initRecords(graph, startVertex);
+  STATS_PHASE(initSeconds, timer);
+  STATS_VAR(long long scanned = 0; long long relaxed = 0;
+            long long failed = 0;)
+
+  while (!isEmpty (rec->heap))
+  {
+    HeapNode u = extractMin (rec->heap);
+    rec->finished[u.id] = true;
+
+    /* Omit adding the start node, because it doesn't have a predecessor. */
+    if (u.id != startVertex)
+      addTreeEdge (rec, rec->numTreeEdges, u.id, rec->predecessors[u.id], u.priority);
+
+    /* Iterate through u's adjacency list. */
+    EdgeList* l = graph->vertices[u.id]->adjList;
+    while (l != NULL)
+    {
+      Vertex *v = graph->vertices[l->edge->toVertex];
+      STATS_VAR(scanned++;)
+      /* If v in heap and w(u, v) less than priority(v) . */
+      if (rec->finished[v->id] == false && 
+          l->edge->weight < getPriority (rec->heap, v->id))
+      {
+        decreasePriority(rec->heap, v->id, l->edge->weight);
+        rec->predecessors[v->id] = u.id; 
+        STATS_VAR(relaxed++;)
+      }
+      /* Counted as the decreasePriority call the check above saves. */
+      else if (rec->finished[v->id] == false)
+      {
+        STATS_VAR(failed++;)
+      }
+      l = l->next;
+    }
+  }
+  STATS_ADD(edgesScanned, scanned);
+  STATS_ADD(relaxations, relaxed);
+  STATS_ADD(decreaseFailed, failed);
+  STATS_PHASE(loopSeconds, timer);
+  
+  Edge *res_tree = newEdgeArr(rec->numTreeEdges, rec->tree);
+  deleteRecords (rec);
+  STATS_PHASE(treeSeconds, timer);
+
+  return res_tree;
+}
+
+Edge* getDistanceTreeDijkstra(Graph* graph, int startVertex)
+{
+  if (!isValidNode (graph, startVertex))
+    return NULL;
+
+  STATS_TIMER(timer);
+  Records* rec = initRecords(graph, startVertex);
+  rec->distances[startVertex] = 0;
+  STATS_PHASE(initSeconds, timer);
+  STATS_VAR(long long scanned = 0; long long relaxed = 0;
+            long long failed = 0;)
+
+  while (!isEmpty (rec->heap))
+  {
+    HeapNode u = extractMin (rec->heap);
+    rec->finished[u.id] = true;
+    
+    /* Iterate through u's adjacency list. */
+    EdgeList* l = graph->vertices[u.id]->adjList;
+    while (l != NULL)
+    {
+      Vertex* v = graph->vertices[l->edge->toVertex];
+      dist_t new_dist = distAdd (u.priority, l->edge->weight);
+      STATS_VAR(scanned++;)
+      /* If v in heap and dist(start, v) less than priority(v) . */
+      if (rec->finished[v->id] == false && new_dist < getPriority(rec->heap, v->id))
+      {
+        decreasePriority(rec->heap, v->id, new_dist);
+        rec->distances[v->id] = new_dist;
+        rec->predecessors[v->id] = u.id; 
+        STATS_VAR(relaxed++;)
+      }
+      /* Counted as the decreasePriority call the check above saves. */
+      else if (rec->finished[v->id] == false)
+      {
+        STATS_VAR(failed++;)
+      }
+      l = l->next;
+    }
+  }
+  STATS_ADD(edgesScanned, scanned);
+  STATS_ADD(relaxations, relaxed);
+  STATS_ADD(decreaseFailed, failed);
+  STATS_PHASE(loopSeconds, timer);
+
+  Edge *res_tree = buildDistanceTree (rec, startVertex);
+  STATS_PHASE(treeSeconds, timer);
+  return res_tree;
+}
+
+Edge* getMSTprimCSR(CSRGraph* csr, int startVertex)
+{
+  if (!(0 <= startVertex && startVertex < csr->numVertices))
+    return NULL;
+
+  STATS_TIMER(timer);
+  Records *rec = newRecords(csr->numVertices, startVertex);
+  const int *offsets = csr->offsets;
+  const int *targets = csr->targets;
+  const int *weights = csr->weights;
+  STATS_PHASE(initSeconds, timer);
+  STATS_VAR(long long scanned = 0; long long relaxed = 0;)
+
+  while (!isEmpty (rec->heap))
+  {
+    HeapNode u = extractMin (rec->heap);
+    rec->finished[u.id] = true;
+
+    /* Omit adding the start node, because it doesn't have a predecessor. */
+    if (u.id != startVertex)
+      addTreeEdge (rec, rec->numTreeEdges, u.id, rec->predecessors[u.id], u.priority);
+
+    /* Scan u's packed edge range. decreasePriority only succeeds if
+     * w(u, v) is less than priority(v). */
+    STATS_VAR(scanned += offsets[u.id + 1] - offsets[u.id];)
+    for (int e = offsets[u.id]; e < offsets[u.id + 1]; e++)
+    {
+      int v = targets[e];
+      if (!rec->finished[v] && decreasePriority (rec->heap, v, weights[e]))
+      {
+        rec->predecessors[v] = u.id;
+        STATS_VAR(relaxed++;)
+      }
+    }
+  }
+  STATS_ADD(edgesScanned, scanned);
+  STATS_ADD(relaxations, relaxed);
+  STATS_PHASE(loopSeconds, timer);
+
+  Edge *res_tree = newEdgeArr(rec->numTreeEdges, rec->tree);
+  deleteRecords (rec);
+  STATS_PHASE(treeSeconds, timer);
+
+  return res_tree;
+}
+
+Edge* getDistanceTreeDijkstraCSR(CSRGraph* csr, int startVertex)
+{
+  if (!(0 <= startVertex && startVertex < csr->numVertices))
+    return NULL;
+
+  STATS_TIMER(timer);
+  Records* rec = newRecords(csr->numVertices, startVertex);
+  rec->distances[startVertex] = 0;
+  const int *offsets = csr->offsets;
+  const int *targets = csr->targets;
+  const int *weights = csr->weights;
+  STATS_PHASE(initSeconds, timer);
+  STATS_VAR(long long scanned = 0; long long relaxed = 0;)
+
+  while (!isEmpty (rec->heap))
+  {
+    HeapNode u = extractMin (rec->heap);
+    rec->finished[u.id] = true;
+
+    STATS_VAR(scanned += offsets[u.id + 1] - offsets[u.id];)
+    for (int e = offsets[u.id]; e < offsets[u.id + 1]; e++)
+    {
+      int v = targets[e];
+      dist_t new_dist = distAdd (u.priority, weights[e]);
+      if (!rec->finished[v] && decreasePriority (rec->heap, v, new_dist))
+      {
+        rec->distances[v] = new_dist;
+        rec->predecessors[v] = u.id;
+        STATS_VAR(relaxed++;)
+      }
+    }
+  }
+  STATS_ADD(edgesScanned, scanned);
+  STATS_ADD(relaxations, relaxed);
+  STATS_PHASE(loopSeconds, timer);
+
+  Edge *res_tree = buildDistanceTree (rec, startVertex);
+  STATS_PHASE(treeSeconds, timer);
+  return res_tree;
+}
+
+Edge* getDistanceTreeDijkstraQueue(Graph* graph, int startVertex, int queueKind,
+                                   int* usedQueue)
+{
+  if (usedQueue)
+    *usedQueue = PQ_BINARY_HEAP;
+  if (!isValidNode (graph, startVertex))
+    return NULL;
+  if (queueKind == PQ_BINARY_HEAP)
+    return getDistanceTreeDijkstra (graph, startVertex);
+
+  /* Dial's algorithm keeps one bucket per possible weight. */
+  dist_t maxWeight = maxEdgeWeight (graph);
+  if (queueKind == PQ_DIAL && maxWeight > DIAL_MAX_WEIGHT)
+    return getDistanceTreeDijkstra (graph, startVertex);
+
+  /* Vertices enter the queue when first reached instead of all up front. */
+  BucketQueue *queue = (queueKind == PQ_DIAL)
+      ? newBucketQueue (BQ_DIAL, graph->numVertices, (int) maxWeight)
+      : newBucketQueue (BQ_RADIX, graph->numVertices, 0);
+  Records* rec = allocRecords(graph->numVertices);
+  for (int id = 0; id < graph->numVertices; id++)
+  {
+    rec->distances[id] = DIST_MAX;
+    rec->predecessors[id] = NOTHING;
+  }
+  rec->distances[startVertex] = 0;
+  bqInsert (queue, 0, startVertex);
+
+  /* The bucket queues keep int keys. Sums past DIST_MAX saturate and are
+   * dropped like in getDistanceTreeDijkstra, which covers a 32-bit dist_t;
+   * a 64-bit distance that does not fit an int key makes the search start
+   * over with the binary heap. */
+  bool fits = true;
+  while (queue->size > 0 && fits)
+  {
+    HeapNode u = bqExtractMin (queue);
+    rec->finished[u.id] = true;
+
+    for (EdgeList *l = graph->vertices[u.id]->adjList; l != NULL; l = l->next)
+    {
+      int v = l->edge->toVertex;
+      dist_t new_dist = distAdd (u.priority, l->edge->weight);
+      if (rec->finished[v] || new_dist >= rec->distances[v])
+        continue;
+      if (new_dist >= INT_MAX)
+      {
+        fits = false;
+        break;
+      }
+
+      if (rec->distances[v] == DIST_MAX)
+        bqInsert (queue, (int) new_dist, v);
+      else
+        bqDecreasePriority (queue, v, (int) new_dist);
+      rec->distances[v] = new_dist;
+      rec->predecessors[v] = u.id;
+    }
+  }
+  deleteBucketQueue (queue);
+
+  if (!fits)
+  {
+    deleteRecords (rec);
+    return getDistanceTreeDijkstra (graph, startVertex);
+  }
+  if (usedQueue)
+    *usedQueue = queueKind;
+  return buildDistanceTree (rec, startVertex);
+}
+
+int searchDijkstra(Workspace* ws, Graph* graph, int source, int target,
+                   dist_t radius)
+{
+  resetWorkspace (ws);
+  wsRelax (ws, source, 0, NOTHING);
+
+  int numSettled = 0;
+  while (!isEmpty (ws->heap) && getMin (ws->heap).priority <= radius)
+  {
+    HeapNode u = wsSettleNext (ws);
+    numSettled++;
+    if (u.id == target)
+      break;
+
+    for (EdgeList *l = graph->vertices[u.id]->adjList; l != NULL; l = l->next)
+      wsRelax (ws, l->edge->toVertex, distAdd (u.priority, l->edge->weight),
+               u.id);
+  }
+  return numSettled;
+}
+
+Edge* getMSTprimWS(Workspace* ws, Graph* graph, int startVertex)
+{
+  if (!isValidNode (graph, startVertex) || ws->numVertices != graph->numVertices)
+    return NULL;
+
+  resetWorkspace (ws);
+  wsRelax (ws, startVertex, 0, NOTHING);
+
+  Edge *tree = (Edge *) malloc (graph->numVertices * sizeof (Edge));
+  int numTreeEdges = 0;
+  while (!isEmpty (ws->heap))
+  {
+    HeapNode u = wsSettleNext (ws);
+
+    /* Omit adding the start node, because it doesn't have a predecessor. */
+    if (u.id != startVertex)
+    {
+      Edge edge = {u.id, ws->predecessors[u.id], u.priority};
+      tree[numTreeEdges++] = edge;
+    }
+
+    /* The key of v is w(u, v); wsRelax skips v if it is finished. */
+    for (EdgeList *l = graph->vertices[u.id]->adjList; l != NULL; l = l->next)
+      wsRelax (ws, l->edge->toVertex, l->edge->weight, u.id);
+  }
+  return tree;
+}
+
+Edge* getDistanceTreeDijkstraWS(Workspace* ws, Graph* graph, int startVertex)
+{
+  if (!isValidNode (graph, startVertex) || ws->numVertices != graph->numVertices)
+    return NULL;
+
+  Edge *tree = (Edge *) malloc (graph->numVertices * sizeof (Edge));
+  fillDistanceTreeWS (ws, graph, startVertex, tree);
+  return tree;
+}
+
+bool fillDistanceTreeWS(Workspace* ws, Graph* graph, int startVertex,
+                        Edge* tree)
+{
+  if (!isValidNode (graph, startVertex) || ws->numVertices != graph->numVertices)
+    return false;
+
+  searchDijkstra (ws, graph, startVertex, NOTHING, DIST_MAX);
+  for (int id = 0; id < graph->numVertices; id++)
+  {
+    Edge edge = {id, wsPredecessor (ws, id), wsDistance (ws, id)};
+    tree[id] = edge;
+  }
+  Edge start = {startVertex, startVertex, 0};
+  tree[startVertex] = start;
+  return true;
+}
+
+dist_t getShortestPathDijkstra(Workspace* ws, Graph* graph, int source,
+                               int target, EdgeList** path)
+{
+  if (path)
+    *path = NULL;
+  if (!isValidNode (graph, source) || !isValidNode (graph, target)
+      || ws->numVertices != graph->numVertices)
+    return NOTHING;
+
+  searchDijkstra (ws, graph, source, target, DIST_MAX);
+  if (!wsSettled (ws, target))
+    return NOTHING;
+
+  if (path)
+    *path = wsPathTo (ws, target);
+  return ws->distances[target];
+}
+
+dist_t getShortestPathBidirectional(Workspace* forward, Workspace* backward,
+                                    Graph* graph, Graph* reverse, int source,
+                                    int target, EdgeList** path)
+{
+  if (path)
+    *path = NULL;
+  if (!isValidNode (graph, source) || !isValidNode (graph, target)
+      || forward->numVertices != graph->numVertices
+      || backward->numVertices != graph->numVertices)
+    return NOTHING;
+  if (reverse == NULL)
+    reverse = graph;
+
+  resetWorkspace (forward);
+  resetWorkspace (backward);
+  wsRelax (forward, source, 0, NOTHING);
+  wsRelax (backward, target, 0, NOTHING);
+
+  dist_t best = (source == target) ? 0 : DIST_MAX;
+  int meet = (source == target) ? source : NOTHING;
+
+  while (!isEmpty (forward->heap) && !isEmpty (backward->heap))
+  {
+    /* No undiscovered path can beat 'best' any more. */
+    if (distAdd (getMin (forward->heap).priority,
+                 getMin (backward->heap).priority) >= best)
+      break;
+
+    /* Advance the side with the smaller frontier key. */
+    bool fwd = getMin (forward->heap).priority
+               <= getMin (backward->heap).priority;
+    Workspace *ws = fwd ? forward : backward;
+    Workspace *other = fwd ? backward : forward;
+    Graph *g = fwd ? graph : reverse;
+
+    HeapNode u = wsSettleNext (ws);
+    for (EdgeList *l = g->vertices[u.id]->adjList; l != NULL; l = l->next)
+    {
+      int v = l->edge->toVertex;
+      wsRelax (ws, v, distAdd (u.priority, l->edge->weight), u.id);
+      if (wsReached (other, v)
+          && distAdd (ws->distances[v], other->distances[v]) < best)
+      {
+        best = distAdd (ws->distances[v], other->distances[v]);
+        meet = v;
+      }
+    }
+  }
+
+  if (meet == NOTHING)
+    return NOTHING;
+
+  if (path)
+  {
+    /* source ~> meet from the forward search, then meet ~> target along
+     * the backward search's predecessors, which point towards target. */
+    EdgeList *head = wsPathTo (forward, meet);
+    EdgeList **tail = &head;
+    while (*tail)
+      tail = &(*tail)->next;
+    for (int v = meet; backward->predecessors[v] != NOTHING;
+         v = backward->predecessors[v])
+    {
+      int next = backward->predecessors[v];
+      dist_t weight = backward->distances[v] - backward->distances[next];
+      *tail = newEdgeList (newEdge (v, next, weight), NULL);
+      tail = &(*tail)->next;
+    }
+    *path = head;
+  }
+  return best;
+}
+
+EdgeList** getShortestPaths(Edge* distTree, int numVertices, int startVertex)
+{
+  if (!(0 <= startVertex && startVertex < numVertices))
+    return NULL;
+  
+  EdgeList **paths = (EdgeList **) malloc (numVertices * sizeof (EdgeList *));
+  paths[startVertex] = NULL;
+
+  for (int id = 0; id < numVertices; id++)
+  {
+    if (id == startVertex)
+      continue;
+
+    paths[id] = makePath (distTree, id, startVertex);
+  }
+
+  return paths;
+}
+
+/*************************************************************************
+ ** Provided helper functions -- part of starter code to help you debug!
+ *************************************************************************/
+void printRecords(Records* records)
+{
+  if (records == NULL)
+    return;
+
+  int numVertices = records->numVertices;
+  printf("Reporting on algorithm's records on %d vertices...\n", numVertices);
+
+  printf("The PQ is:\n");
+  printHeap(records->heap);
+
+  printf("The finished array is:\n");
+  for (int i = 0; i < numVertices; i++)
+    printf("\t%d: %d\n", i, records->finished[i]);
+
+  printf("The predecessors array is:\n");
+  for (int i = 0; i < numVertices; i++)
+    printf("\t%d: %d\n", i, records->predecessors[i]);
+
+  printf("The TREE edges are:\n");
+  for (int i = 0; i < records->numTreeEdges; i++) printEdge(&records->tree[i]);
+
+  printf("... done.\n");
+}
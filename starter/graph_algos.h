@@ -1,51 +1,154 @@
-/*
- * Header file for our graph algorithms.
- *
- * You will NOT be submitting this file. Your code will be tested with
- * our own version of this file, so make sure you do not modify it!
- *
- * Author: Akshay Arun Bapat
- * Based on implementation from A. Tafliovich
- */
-
-#include <stdbool.h>
-#include <stdio.h>
-#include <stdlib.h>
-
-#include "graph.h"
-
-#ifndef __Graph_Algos_header
-#define __Graph_Algos_header
-
-#define NOTHING -1
-#define DEBUG 0
-
-/*
- * Runs Prim's algorithm on Graph 'graph' starting from vertex with ID
- * 'startVertex', and return the resulting MST: an array of Edges.
- * Returns NULL if 'startVertex' is not valid in 'graph'.
- * Precondition: 'graph' is connected.
- */
-Edge* getMSTprim(Graph* graph, int startVertex);
-
-/*
- * Runs Dijkstra's algorithm on Graph 'graph' starting from vertex with ID
- * 'startVertex', and return the resulting distance tree: an array of edges.
- * Returns NULL if 'startVertex' is not valid in 'graph'.
- * Precondition: 'graph' is connected.
- */
-Edge* getDistanceTreeDijkstra(Graph* graph, int startVertex);
-
-/*
- * Creates and returns an array 'paths' of shortest paths from every vertex
- * in the graph to vertex 'startVertex', based on the information in the
- * distance tree 'distTree' produced by Dijkstra's algorithm on a graph with
- * 'numVertices' vertices and with the start vertex 'startVertex'.  paths[id]
- * is the list of edges of the form
- *   [(id -- id_1, w_0), (id_1 -- id_2, w_1), ..., (id_n -- start, w_n)]
- *   where w_0 + w_1 + ... + w_n = distance(id)
- * Returns NULL if 'startVertex' is not valid in 'distTree'.
- */
-EdgeList** getShortestPaths(Edge* distTree, int numVertices, int startVertex);
-
-#endif
+/*
+ * Header file for our graph algorithms.
+ *
+ * You will NOT be submitting this file. Your code will be tested with
+ * our own version of this file, so make sure you do not modify it!
+ *
+ * Author: Akshay Arun Bapat
+ * Based on implementation from A. Tafliovich
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "csr.h"
+#include "graph.h"
+#include "workspace.h"
+
+#ifndef __Graph_Algos_header
+#define __Graph_Algos_header
+
+#define NOTHING -1
+#define DEBUG 0
+
+/* Priority queues getDistanceTreeDijkstraQueue can run on. */
+#define PQ_BINARY_HEAP 0  // the MinHeap, same as getDistanceTreeDijkstra
+#define PQ_DIAL 1         // Dial's buckets; best for small maximum weights
+#define PQ_RADIX 2        // radix heap
+
+// largest edge weight PQ_DIAL takes; it keeps one bucket per weight
+#define DIAL_MAX_WEIGHT (1 << 24)
+
+/*
+ * Runs Prim's algorithm on Graph 'graph' starting from vertex with ID
+ * 'startVertex', and return the resulting MST: an array of Edges.
+ * Returns NULL if 'startVertex' is not valid in 'graph'.
+ * Precondition: 'graph' is connected.
+ */
+Edge* getMSTprim(Graph* graph, int startVertex);
+
+/*
+ * Runs Dijkstra's algorithm on Graph 'graph' starting from vertex with ID
+ * 'startVertex', and return the resulting distance tree: an array of edges.
+ * Returns NULL if 'startVertex' is not valid in 'graph'.
+ * Precondition: 'graph' is connected.
+ */
+Edge* getDistanceTreeDijkstra(Graph* graph, int startVertex);
+
+/*
+ * Same as getDistanceTreeDijkstra, but uses the priority queue selected by
+ * 'queueKind' (one of PQ_BINARY_HEAP, PQ_DIAL, PQ_RADIX). The integer bucket
+ * queues keep int keys: if a distance found turns out not to fit one, the
+ * search starts over with the MinHeap. So does PQ_DIAL if the largest edge
+ * weight is above DIAL_MAX_WEIGHT. If 'usedQueue' is not NULL, it is set to
+ * the queue that computed the result: 'queueKind', or PQ_BINARY_HEAP after
+ * such a fallback.
+ * Returns NULL if 'startVertex' is not valid in 'graph'.
+ * Precondition: 'graph' is connected.
+ */
+Edge* getDistanceTreeDijkstraQueue(Graph* graph, int startVertex, int queueKind,
+                                   int* usedQueue);
+
+/*
+ * Runs Dijkstra's algorithm on Graph 'graph' from vertex with ID 'source',
+ * using and resetting Workspace 'ws', until vertex 'target' is settled
+ * (NOTHING for no target) or all vertices within distance 'radius' are
+ * settled (DIST_MAX for no limit). Distances and predecessors of all reached
+ * vertices are left in 'ws'. Returns the number of settled vertices.
+ * Precondition: 'source' is valid in 'graph', 'ws' was created for 'graph'
+ */
+int searchDijkstra(Workspace* ws, Graph* graph, int source, int target,
+                   dist_t radius);
+
+/*
+ * Same as getMSTprim, but keeps its per-vertex state in Workspace 'ws',
+ * which can be reused across queries without O(n) reinitialisation.
+ * Returns NULL if 'startVertex' is not valid in 'graph' or 'ws' was created
+ * for a different number of vertices.
+ * Precondition: 'graph' is connected.
+ */
+Edge* getMSTprimWS(Workspace* ws, Graph* graph, int startVertex);
+
+/*
+ * Same as getDistanceTreeDijkstra, but keeps its per-vertex state in
+ * Workspace 'ws'. Vertices unreachable from 'startVertex' get the tree edge
+ * (id -- NOTHING, DIST_MAX).
+ * Returns NULL if 'startVertex' is not valid in 'graph' or 'ws' was created
+ * for a different number of vertices.
+ */
+Edge* getDistanceTreeDijkstraWS(Workspace* ws, Graph* graph, int startVertex);
+
+/*
+ * Same as getDistanceTreeDijkstraWS, but writes the distance tree into
+ * 'tree', an array of graph->numVertices Edges provided by the caller, and
+ * returns true. Returns false and leaves 'tree' untouched if 'startVertex'
+ * is not valid in 'graph' or 'ws' was created for a different number of
+ * vertices.
+ */
+bool fillDistanceTreeWS(Workspace* ws, Graph* graph, int startVertex,
+                        Edge* tree);
+
+/*
+ * Runs Dijkstra's algorithm on Graph 'graph' from vertex 'source' using
+ * Workspace 'ws', stopping as soon as vertex 'target' is settled. Returns
+ * distance(source, target), or NOTHING if 'target' is unreachable or either
+ * vertex is not valid. If 'path' is not NULL, '*path' is set to the list of
+ * edges of a shortest path
+ *   [(source -- id_1, w_1), (id_1 -- id_2, w_2), ..., (id_n -- target, w_n)]
+ * which is NULL if source == target or no path exists; the caller frees it
+ * with deleteEdgeList.
+ */
+dist_t getShortestPathDijkstra(Workspace* ws, Graph* graph, int source,
+                               int target, EdgeList** path);
+
+/*
+ * Same as getShortestPathDijkstra, but searches forward from 'source' in
+ * 'graph' and backward from 'target' in 'reverse' (see newReverseGraph)
+ * until the two searches provably meet on a shortest path. 'reverse' may be
+ * NULL when 'graph' is undirected. Uses Workspaces 'forward' and 'backward'.
+ */
+dist_t getShortestPathBidirectional(Workspace* forward, Workspace* backward,
+                                    Graph* graph, Graph* reverse, int source,
+                                    int target, EdgeList** path);
+
+/*
+ * Same as getMSTprim, but runs on the CSR representation 'csr', so that the
+ * edges of every extracted vertex are scanned from contiguous memory.
+ * Returns NULL if 'startVertex' is not valid in 'csr'.
+ * Precondition: 'csr' is connected.
+ */
+Edge* getMSTprimCSR(CSRGraph* csr, int startVertex);
+
+/*
+ * Same as getDistanceTreeDijkstra, but runs on the CSR representation 'csr'.
+ * Returns NULL if 'startVertex' is not valid in 'csr'.
+ * Precondition: 'csr' is connected.
+ */
+Edge* getDistanceTreeDijkstraCSR(CSRGraph* csr, int startVertex);
+
+/*
+ * Creates and returns an array 'paths' of shortest paths from every vertex
+ * in the graph to vertex 'startVertex', based on the information in the
+ * distance tree 'distTree' produced by Dijkstra's algorithm on a graph with
+ * 'numVertices' vertices and with the start vertex 'startVertex'.  paths[id]
+ * is the list of edges of the form
+ *   [(id -- id_1, w_0), (id_1 -- id_2, w_1), ..., (id_n -- start, w_n)]
+ *   where w_0 + w_1 + ... + w_n = distance(id)
+ * Returns NULL if 'startVertex' is not valid in 'distTree'.
+ * Every path is copied edge by edge; to read paths without allocating, walk
+ * 'distTree' with a PathIterator (see path_view.h) instead.
+ */
+EdgeList** getShortestPaths(Edge* distTree, int numVertices, int startVertex);
+
+#endif
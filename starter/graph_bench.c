@@ -0,0 +1,2150 @@
+/*
+ *  Benchmarks for our graph algorithms.
+ *
+ *  ---------------------------------------------------------------------------
+ *   Build:
+ *   make bench
+ *
+ *   Run:
+ *   ./benchprog queues [side] [reps]
+ *      Dijkstra with the binary heap, Dial's buckets and the radix heap on
+ *      a side x side road-like grid, for a range of maximum edge weights;
+ *      a * marks runs that fell back to the binary heap.
+ *
+ *   ./benchprog delta [side] [maxThreads] [delta] [reps]
+ *      Parallel delta-stepping on 1 .. maxThreads threads against
+ *      Dijkstra on a side x side grid.
+ *
+ *   ./benchprog mst [side] [maxThreads] [reps]
+ *      Parallel Borůvka on 1 .. maxThreads threads against Prim on a
+ *      side x side grid.
+ *
+ *   ./benchprog workspace [side] [queries] [radius]
+ *      Back-to-back queries from random sources: getDistanceTreeDijkstra
+ *      against a reused Workspace, for full trees and for searches limited
+ *      to 'radius'.
+ *
+ *   ./benchprog p2p [side] [queries]
+ *      Random source-target queries: full getDistanceTreeDijkstra against
+ *      the point-to-point and bidirectional searches.
+ *
+ *   ./benchprog alt [side] [landmarks] [queries]
+ *      ALT preprocessing cost and size, and ALT queries against full
+ *      getDistanceTreeDijkstra and point-to-point Dijkstra.
+ *
+ *   ./benchprog ch [side] [queries] [file]
+ *      Contraction Hierarchies preprocessing cost and size, a round trip
+ *      through 'file', and CH queries against point-to-point Dijkstra.
+ *
+ *   ./benchprog paths [side] [chain]
+ *      All shortest paths of a distance tree, read through path views
+ *      against getShortestPaths, on a side x side grid and on a path graph
+ *      of 'chain' vertices.
+ *
+ *   ./benchprog load [megabytes] [file] [maxThreads]
+ *      Parse throughput of loadGraph, loadArenaGraph and of the parallel
+ *      loaders on 1 .. maxThreads threads against the fgets-based
+ *      createGraph on a generated input file of about 'megabytes' MB.
+ *
+ *   ./benchprog snapshot [side] [file] [snapshot]
+ *      Start-up time of a binary snapshot against parsing the text 'file'
+ *      of a side x side grid, and Prim and Dijkstra run directly on the
+ *      mapped snapshot against the parsed graph.
+ *
+ *   ./benchprog external [side] [file] [snapshot]
+ *      Out-of-core mode: the time and peak resident set size of Dijkstra
+ *      and Prim on a side x side grid with shuffled vertex IDs, read into
+ *      memory from the text 'file' against run on its mapped snapshot,
+ *      before and after reordering it breadth-first.
+ *
+ *   ./benchprog repair [side] [reps]
+ *      Repairing a distance tree with updateDistanceTree against
+ *      recomputing it with getDistanceTreeDijkstra after batches of
+ *      1 .. 10000 random edge weight changes on a side x side grid.
+ *
+ *   ./benchprog dynmst [side] [updates]
+ *      Keeping the MST of a side x side grid up to date with a DynamicMST
+ *      through random edge reweights, deletions and insertions, against
+ *      rerunning getMSTprim.
+ *
+ *   ./benchprog batch [side] [sources] [maxThreads]
+ *      Distance trees from 'sources' random vertices of a side x side
+ *      grid, one getDistanceTreeDijkstra after the other against a
+ *      QueryPool batch on 1 .. maxThreads threads.
+ *
+ *   ./benchprog table [side] [sources] [targets] [maxThreads]
+ *      A sources x targets distance table of random vertices of a
+ *      side x side grid: one full Dijkstra per source against
+ *      getDistanceTable and getDistanceTableCH on 1 .. maxThreads threads.
+ *
+ *   ./benchprog cache [side] [hot] [queries] [budgetMB]
+ *      Path queries on a side x side grid, 90% of them from 'hot' sources:
+ *      a Dijkstra run per query against a TreeCache of 'budgetMB' MB with
+ *      LRU and with LFU eviction. Halfway through, an edge weight changes
+ *      and the cache is invalidated.
+ *
+ *   ./benchprog reorder [side] [scale] [reps]
+ *      Dijkstra and Prim on a side x side grid with shuffled vertex IDs
+ *      and on an R-MAT graph of 2^scale vertices, as loaded and after
+ *      renumbering the vertices in BFS, reverse Cuthill-McKee and
+ *      decreasing degree order.
+ *
+ *   ./benchprog memory [side] [reps]
+ *      Sizes of the per-edge and per-vertex structures for the dist_t of
+ *      this build (make DIST_BITS=32 or 64), the time and peak resident
+ *      set size of Dijkstra on a side x side grid, and a path longer than
+ *      INT_MAX.
+ *
+ *   ./benchprog suite [graph] [scale] [reps] [format]
+ *      Load, getMSTprim, getDistanceTreeDijkstra and getShortestPaths on a
+ *      seeded generated graph of about 2^scale vertices: rmat, grid, er
+ *      (Erdős–Rényi), geometric, or all of them. Prints percentiles over
+ *      'reps' runs as json or csv; 'make suite' runs all graphs.
+ *  ---------------------------------------------------------------------------
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "algo_stats.h"
+#include "alt.h"
+#include "boruvka.h"
+#include "ch.h"
+#include "csr.h"
+#include "delta_stepping.h"
+#include "distance_table.h"
+#include "dynamic_mst.h"
+#include "dynamic_sssp.h"
+#include "graph.h"
+#include "graph_algos.h"
+#include "graph_gen.h"
+#include "graph_loader.h"
+#include "graph_snapshot.h"
+#include "path_view.h"
+#include "query_pool.h"
+#include "reorder.h"
+#include "tree_cache.h"
+
+/* helpers */
+bool sameDistances(Edge* tree1, Edge* tree2, int numVertices);
+long long treeWeight(Edge* tree, int numEdges);
+long long pathWeight(EdgeList* path);
+unsigned long long graphChecksum(Graph* graph);
+unsigned long long csrChecksum(CSRGraph* csr);
+bool writeRandomGraph(const char* filename, long long bytes, int degree);
+bool writeGraphText(Graph* graph, const char* filename, const int* newIds);
+int* randomPermutation(int n, unsigned seed);
+long long sumDistances(Edge* tree, int numVertices);
+double percentile(double* sorted, int count, double p);
+
+/* benchmarks */
+int benchQueues(int side, int reps);
+int benchDeltaStepping(int side, int maxThreads, int delta, int reps);
+int benchBoruvka(int side, int maxThreads, int reps);
+int benchWorkspace(int side, int numQueries, int radius);
+int benchPointToPoint(int side, int numQueries);
+int benchALT(int side, int numLandmarks, int numQueries);
+int benchCH(int side, int numQueries, const char* filename);
+int benchPaths(int side, int chain);
+int timePaths(const char* name, Graph* graph);
+int benchLoad(int megabytes, const char* filename, int maxThreads);
+int benchSnapshot(int side, const char* filename, const char* snapshotName);
+int benchExternal(int side, const char* filename, const char* snapshotName);
+long long externalPhase(int phase, int side, const char* names[3]);
+long long measurePhase(const char* name, int phase, int side,
+                       const char* names[3]);
+int benchRepair(int side, int reps);
+EdgeList* randomEdge(Graph* graph, unsigned* state);
+int benchDynamicMST(int side, int numUpdates);
+void setUndirectedWeight(Graph* graph, Edge* edge, dist_t weight);
+int benchBatch(int side, int numSources, int maxThreads);
+int benchTable(int side, int numSources, int numTargets, int maxThreads);
+int benchCache(int side, int numHot, int numQueries, int budgetMB);
+int benchReorder(int side, int scale, int reps);
+int timeOrders(const char* name, Graph* graph, int reps);
+double averageEdgeSpan(Graph* graph);
+int benchMemory(int side, int reps);
+int benchSuite(const char* kind, int scale, int reps, const char* format);
+Graph* suiteGraph(const char* kind, int scale);
+void printSuiteRow(const char* format, bool first, const char* kind,
+                   int scale, Graph* graph, const char* operation,
+                   double* seconds, int reps);
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    printf("Usage: %s queues [side] [reps]\n"
+           "       %s delta [side] [maxThreads] [delta] [reps]\n"
+           "       %s mst [side] [maxThreads] [reps]\n"
+           "       %s workspace [side] [queries] [radius]\n"
+           "       %s p2p [side] [queries]\n"
+           "       %s alt [side] [landmarks] [queries]\n"
+           "       %s ch [side] [queries] [file]\n"
+           "       %s paths [side] [chain]\n"
+           "       %s load [megabytes] [file] [maxThreads]\n"
+           "       %s snapshot [side] [file] [snapshot]\n"
+           "       %s external [side] [file] [snapshot]\n"
+           "       %s repair [side] [reps]\n"
+           "       %s dynmst [side] [updates]\n"
+           "       %s batch [side] [sources] [maxThreads]\n"
+           "       %s table [side] [sources] [targets] [maxThreads]\n"
+           "       %s cache [side] [hot] [queries] [budgetMB]\n"
+           "       %s reorder [side] [scale] [reps]\n"
+           "       %s memory [side] [reps]\n"
+           "       %s suite [graph] [scale] [reps] [format]\n",
+           argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0],
+           argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0],
+           argv[0], argv[0], argv[0], argv[0], argv[0]);
+    return 1;
+  }
+
+  if (strcmp(argv[1], "queues") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 300;
+    int reps = argc > 3 ? atoi(argv[3]) : 3;
+    return benchQueues(side, reps);
+  }
+
+  if (strcmp(argv[1], "delta") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 500;
+    int maxThreads = argc > 3 ? atoi(argv[3]) : 8;
+    int delta = argc > 4 ? atoi(argv[4]) : 0;
+    int reps = argc > 5 ? atoi(argv[5]) : 3;
+    return benchDeltaStepping(side, maxThreads, delta, reps);
+  }
+
+  if (strcmp(argv[1], "mst") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 500;
+    int maxThreads = argc > 3 ? atoi(argv[3]) : 8;
+    int reps = argc > 4 ? atoi(argv[4]) : 3;
+    return benchBoruvka(side, maxThreads, reps);
+  }
+
+  if (strcmp(argv[1], "workspace") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 500;
+    int numQueries = argc > 3 ? atoi(argv[3]) : 20;
+    int radius = argc > 4 ? atoi(argv[4]) : 500;
+    return benchWorkspace(side, numQueries, radius);
+  }
+
+  if (strcmp(argv[1], "p2p") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 500;
+    int numQueries = argc > 3 ? atoi(argv[3]) : 20;
+    return benchPointToPoint(side, numQueries);
+  }
+
+  if (strcmp(argv[1], "alt") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 500;
+    int numLandmarks = argc > 3 ? atoi(argv[3]) : 8;
+    int numQueries = argc > 4 ? atoi(argv[4]) : 20;
+    return benchALT(side, numLandmarks, numQueries);
+  }
+
+  if (strcmp(argv[1], "ch") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 200;
+    int numQueries = argc > 3 ? atoi(argv[3]) : 20;
+    const char* filename = argc > 4 ? argv[4] : "grid.ch";
+    return benchCH(side, numQueries, filename);
+  }
+
+  if (strcmp(argv[1], "paths") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 300;
+    int chain = argc > 3 ? atoi(argv[3]) : 5000;
+    return benchPaths(side, chain);
+  }
+
+  if (strcmp(argv[1], "load") == 0)
+  {
+    int megabytes = argc > 2 ? atoi(argv[2]) : 1024;
+    const char* filename = argc > 3 ? argv[3] : "random_graph.txt";
+    int maxThreads = argc > 4 ? atoi(argv[4]) : 8;
+    return benchLoad(megabytes, filename, maxThreads);
+  }
+
+  if (strcmp(argv[1], "snapshot") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 1000;
+    const char* filename = argc > 3 ? argv[3] : "grid.txt";
+    const char* snapshotName = argc > 4 ? argv[4] : "grid.snap";
+    return benchSnapshot(side, filename, snapshotName);
+  }
+
+  if (strcmp(argv[1], "external") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 1000;
+    const char* filename = argc > 3 ? argv[3] : "shuffled_grid.txt";
+    const char* snapshotName = argc > 4 ? argv[4] : "shuffled_grid.snap";
+    return benchExternal(side, filename, snapshotName);
+  }
+
+  if (strcmp(argv[1], "repair") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 500;
+    int reps = argc > 3 ? atoi(argv[3]) : 5;
+    return benchRepair(side, reps);
+  }
+
+  if (strcmp(argv[1], "dynmst") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 500;
+    int numUpdates = argc > 3 ? atoi(argv[3]) : 100000;
+    return benchDynamicMST(side, numUpdates);
+  }
+
+  if (strcmp(argv[1], "batch") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 300;
+    int numSources = argc > 3 ? atoi(argv[3]) : 64;
+    int maxThreads = argc > 4 ? atoi(argv[4]) : 8;
+    return benchBatch(side, numSources, maxThreads);
+  }
+
+  if (strcmp(argv[1], "table") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 200;
+    int numSources = argc > 3 ? atoi(argv[3]) : 200;
+    int numTargets = argc > 4 ? atoi(argv[4]) : 200;
+    int maxThreads = argc > 5 ? atoi(argv[5]) : 8;
+    return benchTable(side, numSources, numTargets, maxThreads);
+  }
+
+  if (strcmp(argv[1], "cache") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 200;
+    int numHot = argc > 3 ? atoi(argv[3]) : 100;
+    int numQueries = argc > 4 ? atoi(argv[4]) : 1000;
+    int budgetMB = argc > 5 ? atoi(argv[5]) : 32;
+    return benchCache(side, numHot, numQueries, budgetMB);
+  }
+
+  if (strcmp(argv[1], "reorder") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 700;
+    int scale = argc > 3 ? atoi(argv[3]) : 18;
+    int reps = argc > 4 ? atoi(argv[4]) : 3;
+    return benchReorder(side, scale, reps);
+  }
+
+  if (strcmp(argv[1], "memory") == 0)
+  {
+    int side = argc > 2 ? atoi(argv[2]) : 1000;
+    int reps = argc > 3 ? atoi(argv[3]) : 3;
+    return benchMemory(side, reps);
+  }
+
+  if (strcmp(argv[1], "suite") == 0)
+  {
+    const char* kind = argc > 2 ? argv[2] : "all";
+    int scale = argc > 3 ? atoi(argv[3]) : 14;
+    int reps = argc > 4 ? atoi(argv[4]) : 5;
+    const char* format = argc > 5 ? argv[5] : "json";
+    return benchSuite(kind, scale, reps, format);
+  }
+
+  printf("Unknown benchmark: %s\n", argv[1]);
+  return 1;
+}
+
+/*
+ * Times Dijkstra's algorithm with every priority queue on grids with
+ * increasing maximum edge weight, and prints one row per weight. Times of
+ * runs that fell back to the binary heap are marked with a '*'. Returns 0
+ * iff all queues produced the same distances.
+ */
+int benchQueues(int side, int reps)
+{
+  static const int maxWeights[] = {1, 4, 16, 64, 256, 1024, 16384, 1 << 20};
+  static const char* names[] = {"binary", "dial", "radix"};
+  int numWeights = sizeof(maxWeights) / sizeof(maxWeights[0]);
+
+  printf("Dijkstra on a %d x %d grid, best of %d runs (ms)\n", side, side,
+         reps);
+  printf("%10s %10s  %10s  %10s\n", "maxWeight", names[0], names[1], names[2]);
+
+  int status = 0;
+  bool fellBack = false;
+  for (int i = 0; i < numWeights; i++)
+  {
+    Graph* graph = gridGraph(side, maxWeights[i], 42);
+    Edge* reference = getDistanceTreeDijkstra(graph, 0);
+
+    printf("%10d", maxWeights[i]);
+    for (int queue = PQ_BINARY_HEAP; queue <= PQ_RADIX; queue++)
+    {
+      double best = -1;
+      int used = queue;
+      for (int r = 0; r < reps; r++)
+      {
+        double start = statsNow();
+        Edge* tree = getDistanceTreeDijkstraQueue(graph, 0, queue, &used);
+        double elapsed = statsNow() - start;
+
+        if (!sameDistances(reference, tree, graph->numVertices))
+        {
+          fprintf(stderr, "%s queue computed wrong distances\n", names[queue]);
+          status = 1;
+        }
+        free(tree);
+        if (best < 0 || elapsed < best)
+          best = elapsed;
+      }
+      printf(" %10.2f%c", best * 1000, used == queue ? ' ' : '*');
+      fellBack = fellBack || used != queue;
+    }
+    printf("\n");
+
+    free(reference);
+    deleteGraph(graph);
+  }
+  if (fellBack)
+    printf("* fell back to the binary heap\n");
+  return status;
+}
+
+/*
+ * Times delta-stepping with 1, 2, 4, ... 'maxThreads' threads, each count
+ * on one team kept for all its runs, against Dijkstra on a 'side' x 'side'
+ * grid with weights in [1, 100], and prints the time and speedup of every
+ * thread count. Returns 0 iff all runs produced the same distances as
+ * Dijkstra.
+ */
+int benchDeltaStepping(int side, int maxThreads, int delta, int reps)
+{
+  Graph* graph = gridGraph(side, 100, 42);
+  CSRGraph* csr = csrFromGraph(graph);
+  int status = 0;
+
+  double dijkstra = -1;
+  Edge* reference = NULL;
+  for (int r = 0; r < reps; r++)
+  {
+    free(reference);
+    double start = statsNow();
+    reference = getDistanceTreeDijkstraCSR(csr, 0);
+    double elapsed = statsNow() - start;
+    if (dijkstra < 0 || elapsed < dijkstra)
+      dijkstra = elapsed;
+  }
+
+  printf("Delta-stepping on a %d x %d grid, delta %d, best of %d runs\n",
+         side, side, delta, reps);
+  printf("%10s %10.2f ms\n", "dijkstra", dijkstra * 1000);
+  printf("%10s %10s %10s\n", "threads", "ms", "speedup");
+
+  double single = -1;
+  for (int threads = 1; threads <= maxThreads; threads *= 2)
+  {
+    ThreadTeam* team = newThreadTeam(threads);
+    double best = -1;
+    for (int r = 0; r < reps; r++)
+    {
+      double start = statsNow();
+      Edge* tree = getDistanceTreeDeltaSteppingTeam(csr, 0, delta, team);
+      double elapsed = statsNow() - start;
+
+      if (!sameDistances(reference, tree, csr->numVertices))
+      {
+        fprintf(stderr, "delta-stepping on %d threads computed wrong "
+                "distances\n", threads);
+        status = 1;
+      }
+      free(tree);
+      if (best < 0 || elapsed < best)
+        best = elapsed;
+    }
+    deleteThreadTeam(team);
+    if (single < 0)
+      single = best;
+    printf("%10d %10.2f %10.2f\n", threads, best * 1000, single / best);
+  }
+
+  free(reference);
+  deleteCSRGraph(csr);
+  deleteGraph(graph);
+  return status;
+}
+
+/*
+ * Returns the total weight of the 'numEdges' edges in 'tree'.
+ */
+long long treeWeight(Edge* tree, int numEdges)
+{
+  long long total = 0;
+  for (int i = 0; i < numEdges; i++)
+    total += tree[i].weight;
+  return total;
+}
+
+/*
+ * Times Borůvka with 1, 2, 4, ... 'maxThreads' threads against Prim on a
+ * 'side' x 'side' grid with weights in [1, 100], and prints the time and
+ * speedup of every thread count. Returns 0 iff all runs found a spanning
+ * tree of the same total weight as Prim's.
+ */
+int benchBoruvka(int side, int maxThreads, int reps)
+{
+  Graph* graph = gridGraph(side, 100, 42);
+  CSRGraph* csr = csrFromGraph(graph);
+  int numVertices = csr->numVertices;
+  int status = 0;
+
+  double prim = -1;
+  long long primWeight = 0;
+  for (int r = 0; r < reps; r++)
+  {
+    double start = statsNow();
+    Edge* mst = getMSTprimCSR(csr, 0);
+    double elapsed = statsNow() - start;
+    primWeight = treeWeight(mst, numVertices - 1);
+    free(mst);
+    if (prim < 0 || elapsed < prim)
+      prim = elapsed;
+  }
+
+  printf("Borůvka on a %d x %d grid, best of %d runs\n", side, side, reps);
+  printf("%10s %10.2f ms\n", "prim", prim * 1000);
+  printf("%10s %10s %10s\n", "threads", "ms", "speedup");
+
+  double single = -1;
+  for (int threads = 1; threads <= maxThreads; threads *= 2)
+  {
+    double best = -1;
+    for (int r = 0; r < reps; r++)
+    {
+      int numTreeEdges = 0;
+      double start = statsNow();
+      Edge* forest = getMSFboruvkaCSR(csr, threads, &numTreeEdges);
+      double elapsed = statsNow() - start;
+
+      if (numTreeEdges != numVertices - 1
+          || treeWeight(forest, numTreeEdges) != primWeight)
+      {
+        fprintf(stderr, "Borůvka on %d threads found a wrong tree\n",
+                threads);
+        status = 1;
+      }
+      free(forest);
+      if (best < 0 || elapsed < best)
+        best = elapsed;
+    }
+    if (single < 0)
+      single = best;
+    printf("%10d %10.2f %10.2f\n", threads, best * 1000, single / best);
+  }
+
+  deleteCSRGraph(csr);
+  deleteGraph(graph);
+  return status;
+}
+
+/*
+ * Times 'numQueries' back-to-back queries from random sources on a 'side' x
+ * 'side' grid with weights in [1, 100]: full distance trees with fresh
+ * Records and with one reused Workspace, and searches limited to 'radius'
+ * with the Workspace. Returns 0 iff the full trees agree.
+ */
+int benchWorkspace(int side, int numQueries, int radius)
+{
+  Graph* graph = gridGraph(side, 100, 42);
+  Workspace* ws = newWorkspace(graph->numVertices);
+  unsigned state = 7;
+  int status = 0;
+  double fresh = 0, reused = 0, bounded = 0;
+  long long settled = 0;
+
+  for (int q = 0; q < numQueries; q++)
+  {
+    int source = nextRandom(&state) % graph->numVertices;
+
+    double start = statsNow();
+    Edge* tree1 = getDistanceTreeDijkstra(graph, source);
+    double mid = statsNow();
+    Edge* tree2 = getDistanceTreeDijkstraWS(ws, graph, source);
+    double end = statsNow();
+    settled += searchDijkstra(ws, graph, source, NOTHING, radius);
+    bounded += statsNow() - end;
+
+    fresh += mid - start;
+    reused += end - mid;
+    if (!sameDistances(tree1, tree2, graph->numVertices))
+    {
+      fprintf(stderr, "workspace query from %d computed wrong distances\n",
+              source);
+      status = 1;
+    }
+    free(tree1);
+    free(tree2);
+  }
+
+  printf("%d queries on a %d x %d grid, mean ms per query\n", numQueries,
+         side, side);
+  printf("%28s %10.3f\n", "full tree, fresh Records", fresh * 1000 / numQueries);
+  printf("%28s %10.3f\n", "full tree, reused Workspace",
+         reused * 1000 / numQueries);
+  printf("%22s %5d %10.3f (%lld vertices settled per query)\n",
+         "radius", radius, bounded * 1000 / numQueries, settled / numQueries);
+
+  deleteWorkspace(ws);
+  deleteGraph(graph);
+  return status;
+}
+
+/*
+ * Returns the sum of the weights of the edges in 'path'.
+ */
+long long pathWeight(EdgeList* path)
+{
+  long long total = 0;
+  for (; path != NULL; path = path->next)
+    total += path->edge->weight;
+  return total;
+}
+
+/*
+ * Times 'numQueries' random source-target queries on a 'side' x 'side' grid
+ * with weights in [1, 100]: a full distance tree, a point-to-point search
+ * and a bidirectional search. Returns 0 iff all three agree and the
+ * returned paths have the returned lengths.
+ */
+int benchPointToPoint(int side, int numQueries)
+{
+  Graph* graph = gridGraph(side, 100, 42);
+  Workspace* forward = newWorkspace(graph->numVertices);
+  Workspace* backward = newWorkspace(graph->numVertices);
+  unsigned state = 11;
+  int status = 0;
+  double full = 0, single = 0, bidir = 0;
+
+  for (int q = 0; q < numQueries; q++)
+  {
+    int source = nextRandom(&state) % graph->numVertices;
+    int target = nextRandom(&state) % graph->numVertices;
+    EdgeList* path1 = NULL;
+    EdgeList* path2 = NULL;
+
+    double t0 = statsNow();
+    Edge* tree = getDistanceTreeDijkstra(graph, source);
+    double t1 = statsNow();
+    dist_t d1 = getShortestPathDijkstra(forward, graph, source, target, &path1);
+    double t2 = statsNow();
+    dist_t d2 = getShortestPathBidirectional(forward, backward, graph, NULL,
+                                             source, target, &path2);
+    double t3 = statsNow();
+
+    full += t1 - t0;
+    single += t2 - t1;
+    bidir += t3 - t2;
+    if (d1 != tree[target].weight || d2 != d1 || pathWeight(path1) != d1
+        || pathWeight(path2) != d2)
+    {
+      fprintf(stderr, "query %d -> %d: tree %" PRIdist ", p2p %" PRIdist
+              ", bidirectional %" PRIdist "\n", source, target,
+              tree[target].weight, d1, d2);
+      status = 1;
+    }
+    free(tree);
+    deleteEdgeList(path1);
+    deleteEdgeList(path2);
+  }
+
+  printf("%d s-t queries on a %d x %d grid, mean ms per query\n", numQueries,
+         side, side);
+  printf("%16s %10.3f\n", "full tree", full * 1000 / numQueries);
+  printf("%16s %10.3f\n", "point-to-point", single * 1000 / numQueries);
+  printf("%16s %10.3f\n", "bidirectional", bidir * 1000 / numQueries);
+
+  deleteWorkspace(forward);
+  deleteWorkspace(backward);
+  deleteGraph(graph);
+  return status;
+}
+
+/*
+ * Preprocesses 'numLandmarks' landmarks on a 'side' x 'side' grid with
+ * weights in [1, 100], then times 'numQueries' random source-target queries
+ * with a full distance tree, point-to-point Dijkstra and ALT. Returns 0 iff
+ * all three agree.
+ */
+int benchALT(int side, int numLandmarks, int numQueries)
+{
+  Graph* graph = gridGraph(side, 100, 42);
+  Workspace* ws = newWorkspace(graph->numVertices);
+  Landmarks* lm = newLandmarks(graph, NULL, numLandmarks);
+  unsigned state = 13;
+  int status = 0;
+  double full = 0, single = 0, alt = 0;
+  long long reachedDijkstra = 0, reachedALT = 0;
+
+  for (int q = 0; q < numQueries; q++)
+  {
+    int source = nextRandom(&state) % graph->numVertices;
+    int target = nextRandom(&state) % graph->numVertices;
+    EdgeList* path = NULL;
+
+    double t0 = statsNow();
+    Edge* tree = getDistanceTreeDijkstra(graph, source);
+    double t1 = statsNow();
+    dist_t d1 = getShortestPathDijkstra(ws, graph, source, target, NULL);
+    double t2 = statsNow();
+    reachedDijkstra += ws->numTouched;
+    dist_t d2 = getShortestPathALT(lm, ws, graph, source, target, &path);
+    double t3 = statsNow();
+    reachedALT += ws->numTouched;
+
+    full += t1 - t0;
+    single += t2 - t1;
+    alt += t3 - t2;
+    if (d1 != tree[target].weight || d2 != d1 || pathWeight(path) != d2)
+    {
+      fprintf(stderr, "query %d -> %d: tree %" PRIdist ", p2p %" PRIdist
+              ", ALT %" PRIdist "\n", source, target,
+              tree[target].weight, d1, d2);
+      status = 1;
+    }
+    free(tree);
+    deleteEdgeList(path);
+  }
+
+  printf("ALT with %d landmarks on a %d x %d grid\n", lm->numLandmarks, side,
+         side);
+  printf("preprocessing: %.1f ms, %zu bytes\n", lm->preprocessSeconds * 1000,
+         landmarksBytes(lm));
+  printf("%d s-t queries, mean ms per query\n", numQueries);
+  printf("%16s %10.3f\n", "full tree", full * 1000 / numQueries);
+  printf("%16s %10.3f %10lld reached\n", "point-to-point",
+         single * 1000 / numQueries, reachedDijkstra / numQueries);
+  printf("%16s %10.3f %10lld reached\n", "ALT", alt * 1000 / numQueries,
+         reachedALT / numQueries);
+
+  deleteLandmarks(lm);
+  deleteWorkspace(ws);
+  deleteGraph(graph);
+  return status;
+}
+
+/*
+ * Contracts a 'side' x 'side' grid with weights in [1, 100], saves the
+ * hierarchy to 'filename' and loads it back, then times 'numQueries' random
+ * source-target queries with point-to-point Dijkstra and with both
+ * hierarchies. Returns 0 iff all queries agree.
+ */
+int benchCH(int side, int numQueries, const char* filename)
+{
+  Graph* graph = gridGraph(side, 100, 42);
+  ContractionHierarchy* ch = newContractionHierarchy(graph);
+  if (!saveContractionHierarchy(ch, filename))
+  {
+    fprintf(stderr, "cannot write %s\n", filename);
+    deleteContractionHierarchy(ch);
+    deleteGraph(graph);
+    return 1;
+  }
+  double t0 = statsNow();
+  ContractionHierarchy* loaded = loadContractionHierarchy(filename);
+  double loadSeconds = statsNow() - t0;
+  if (loaded == NULL)
+  {
+    fprintf(stderr, "cannot read %s\n", filename);
+    deleteContractionHierarchy(ch);
+    deleteGraph(graph);
+    return 1;
+  }
+
+  Workspace* forward = newWorkspace(graph->numVertices);
+  Workspace* backward = newWorkspace(graph->numVertices);
+  unsigned state = 13;
+  int status = 0;
+  double single = 0, query = 0;
+  long long reachedDijkstra = 0, reachedCH = 0;
+
+  for (int q = 0; q < numQueries; q++)
+  {
+    int source = nextRandom(&state) % graph->numVertices;
+    int target = nextRandom(&state) % graph->numVertices;
+    EdgeList* path = NULL;
+
+    double t1 = statsNow();
+    dist_t d1 = getShortestPathDijkstra(forward, graph, source, target, NULL);
+    double t2 = statsNow();
+    reachedDijkstra += forward->numTouched;
+    dist_t d2 = getShortestPathCH(ch, forward, backward, source, target, &path);
+    double t3 = statsNow();
+    reachedCH += forward->numTouched + backward->numTouched;
+    dist_t d3 = getShortestPathCH(loaded, forward, backward, source, target,
+                                  NULL);
+
+    single += t2 - t1;
+    query += t3 - t2;
+    if (d2 != d1 || d3 != d1 || pathWeight(path) != d2)
+    {
+      fprintf(stderr, "query %d -> %d: p2p %" PRIdist ", CH %" PRIdist
+              ", loaded CH %" PRIdist "\n", source, target, d1, d2, d3);
+      status = 1;
+    }
+    deleteEdgeList(path);
+  }
+
+  printf("Contraction Hierarchies on a %d x %d grid\n", side, side);
+  printf("preprocessing: %.1f ms, %d shortcuts, %zu bytes\n",
+         ch->preprocessSeconds * 1000, ch->numShortcuts, chBytes(ch));
+  printf("loading %s: %.1f ms\n", filename, loadSeconds * 1000);
+  printf("%d s-t queries, mean ms per query\n", numQueries);
+  printf("%16s %10.3f %10lld reached\n", "point-to-point",
+         single * 1000 / numQueries, reachedDijkstra / numQueries);
+  printf("%16s %10.3f %10lld reached\n", "CH", query * 1000 / numQueries,
+         reachedCH / numQueries);
+
+  deleteWorkspace(forward);
+  deleteWorkspace(backward);
+  deleteContractionHierarchy(loaded);
+  deleteContractionHierarchy(ch);
+  deleteGraph(graph);
+  return status;
+}
+
+/*
+ * Times reading every shortest path of the distance tree of 'graph' from
+ * vertex 0, once copied with getShortestPaths and once through path views,
+ * and prints one row named 'name'. Returns 0 iff both agree with the tree.
+ */
+int timePaths(const char* name, Graph* graph)
+{
+  int n = graph->numVertices;
+  Edge* tree = getDistanceTreeDijkstra(graph, 0);
+  int status = 0;
+  long long hops = 0;
+
+  double t0 = statsNow();
+  EdgeList** paths = getShortestPaths(tree, n, 0);
+  for (int id = 0; id < n; id++)
+    if (pathWeight(paths[id]) != tree[id].weight)
+      status = 1;
+  for (int id = 0; id < n; id++)
+    deleteEdgeList(paths[id]);
+  free(paths);
+  double t1 = statsNow();
+
+  for (int id = 0; id < n; id++)
+  {
+    PathIterator it = pathIterator(tree, 0, id);
+    Edge edge;
+    long long total = 0;
+    while (pathNext(&it, &edge))
+    {
+      total += edge.weight;
+      hops++;
+    }
+    if (total != tree[id].weight)
+      status = 1;
+  }
+  double t2 = statsNow();
+
+  printf("%16s %10d %12lld %12.2f %12.2f\n", name, n, hops,
+         (t1 - t0) * 1000, (t2 - t1) * 1000);
+  free(tree);
+  return status;
+}
+
+/*
+ * Compares getShortestPaths with path views on a 'side' x 'side' grid and
+ * on a path graph of 'chain' vertices, where the total length of all paths
+ * is quadratic. Returns 0 iff all paths agree with the distance tree.
+ */
+int benchPaths(int side, int chain)
+{
+  printf("all shortest paths from vertex 0, ms\n");
+  printf("%16s %10s %12s %12s %12s\n", "graph", "vertices", "total hops",
+         "EdgeLists", "views");
+
+  Graph* grid = gridGraph(side, 100, 42);
+  int status = timePaths("grid", grid);
+  deleteGraph(grid);
+
+  Graph* line = newArenaGraph(chain, 2 * chain);
+  for (int id = 0; id < chain; id++)
+    line->vertices[id] = graphNewVertex(line, id, NULL, NULL);
+  unsigned state = 42;
+  for (int id = 0; id + 1 < chain; id++)
+    addUndirectedEdge(line, id, id + 1, 1 + nextRandom(&state) % 100);
+  status |= timePaths("path graph", line);
+  deleteGraph(line);
+  return status;
+}
+
+/*
+ * Writes a random graph of about 'megabytes' MB to the input file
+ * 'filename', then reads it with createGraph, loadGraph, loadArenaGraph, and
+ * loadGraphParallel and loadCSRParallel on 1, 2, 4, ... 'maxThreads'
+ * threads, and prints the throughput of each. Returns 0 iff all read the
+ * same graph.
+ */
+int benchLoad(int megabytes, const char* filename, int maxThreads)
+{
+  long long bytes = (long long) megabytes << 20;
+  double t0 = statsNow();
+  if (!writeRandomGraph(filename, bytes, 8))
+  {
+    fprintf(stderr, "cannot write %s\n", filename);
+    return 1;
+  }
+  double t1 = statsNow();
+  printf("wrote %d MB to %s in %.1f s\n", megabytes, filename, t1 - t0);
+
+  /* Only one graph is kept in memory at a time; they are compared by
+   * checksum. */
+  FILE* f = fopen(filename, "r");
+  t0 = statsNow();
+  Graph* graph = createGraph(f);
+  t1 = statsNow();
+  fclose(f);
+  unsigned long long slowChecksum = graph ? graphChecksum(graph) : 0;
+  if (graph != NULL)
+    deleteGraph(graph);
+
+  double t2 = statsNow();
+  graph = loadGraph(filename);
+  double t3 = statsNow();
+  if (graph == NULL)
+    return 1;
+
+  int status = graphChecksum(graph) != slowChecksum;
+  printf("%d vertices, %d edges\n", graph->numVertices, graph->numEdges);
+  deleteGraph(graph);
+
+  double t4 = statsNow();
+  graph = loadArenaGraph(filename);
+  double t5 = statsNow();
+  status |= graph == NULL || graphChecksum(graph) != slowChecksum;
+  if (graph != NULL)
+    deleteGraph(graph);
+
+  printf("%16s %10s %10s\n", "reader", "seconds", "MB/s");
+  printf("%16s %10.2f %10.1f\n", "createGraph", t1 - t0,
+         megabytes / (t1 - t0));
+  printf("%16s %10.2f %10.1f\n", "loadGraph", t3 - t2,
+         megabytes / (t3 - t2));
+  printf("%16s %10.2f %10.1f\n", "loadArenaGraph", t5 - t4,
+         megabytes / (t5 - t4));
+
+  for (int threads = 1; threads <= maxThreads; threads *= 2)
+  {
+    char name[32];
+    t0 = statsNow();
+    graph = loadGraphParallel(filename, threads);
+    t1 = statsNow();
+    status |= graph == NULL || graphChecksum(graph) != slowChecksum;
+    if (graph != NULL)
+      deleteGraph(graph);
+    snprintf(name, sizeof(name), "Graph, %d thr", threads);
+    printf("%16s %10.2f %10.1f\n", name, t1 - t0, megabytes / (t1 - t0));
+
+    t0 = statsNow();
+    CSRGraph* csr = loadCSRParallel(filename, threads);
+    t1 = statsNow();
+    status |= csr == NULL || csrChecksum(csr) != slowChecksum;
+    deleteCSRGraph(csr);
+    snprintf(name, sizeof(name), "CSR, %d thr", threads);
+    printf("%16s %10.2f %10.1f\n", name, t1 - t0, megabytes / (t1 - t0));
+  }
+
+  if (status)
+    fprintf(stderr, "the readers disagree\n");
+  return status;
+}
+
+/*
+ * Writes a 'side' x 'side' grid with weights in [1, 100] to the input file
+ * 'filename', parses it and saves it as the snapshot 'snapshotName', then
+ * compares the time to parse the text with the time to open the snapshot,
+ * and Prim and Dijkstra on the parsed graph with the same algorithms on the
+ * mapped arrays. Returns 0 iff the snapshot holds the parsed graph and both
+ * give the same results.
+ */
+int benchSnapshot(int side, const char* filename, const char* snapshotName)
+{
+  Graph* graph = gridGraph(side, 100, 42);
+  bool written = writeGraphText(graph, filename, NULL);
+  deleteGraph(graph);
+  if (!written)
+  {
+    fprintf(stderr, "cannot write %s\n", filename);
+    return 1;
+  }
+
+  double t0 = statsNow();
+  CSRGraph* parsed = loadCSRParallel(filename, 1);
+  double t1 = statsNow();
+  if (parsed == NULL)
+    return 1;
+  double parseTime = t1 - t0;
+
+  t0 = statsNow();
+  written = writeSnapshot(parsed, snapshotName);
+  t1 = statsNow();
+  if (!written)
+  {
+    fprintf(stderr, "cannot write %s\n", snapshotName);
+    deleteCSRGraph(parsed);
+    return 1;
+  }
+  printf("%d vertices, %d edges; snapshot written in %.2f s\n",
+         parsed->numVertices, parsed->numEdges, t1 - t0);
+
+  t0 = statsNow();
+  GraphSnapshot* snapshot = openSnapshot(snapshotName, false);
+  t1 = statsNow();
+  double openTime = t1 - t0;
+  closeSnapshot(snapshot);
+
+  t0 = statsNow();
+  snapshot = openSnapshot(snapshotName, true);
+  t1 = statsNow();
+  double verifyTime = t1 - t0;
+  if (snapshot == NULL)
+  {
+    deleteCSRGraph(parsed);
+    return 1;
+  }
+
+  printf("%24s %12s\n", "start-up", "seconds");
+  printf("%24s %12.6f\n", "parse text", parseTime);
+  printf("%24s %12.6f\n", "open snapshot", openTime);
+  printf("%24s %12.6f\n", "open and verify", verifyTime);
+
+  int status = csrChecksum(&snapshot->csr) != csrChecksum(parsed);
+  int n = parsed->numVertices;
+
+  t0 = statsNow();
+  Edge* parsedTree = getDistanceTreeDijkstraCSR(parsed, 0);
+  t1 = statsNow();
+  Edge* mappedTree = getDistanceTreeDijkstraCSR(&snapshot->csr, 0);
+  double t2 = statsNow();
+  status |= !sameDistances(parsedTree, mappedTree, n);
+  printf("%24s %12.3f\n", "Dijkstra, parsed", t1 - t0);
+  printf("%24s %12.3f\n", "Dijkstra, mapped", t2 - t1);
+  free(parsedTree);
+  free(mappedTree);
+
+  t0 = statsNow();
+  parsedTree = getMSTprimCSR(parsed, 0);
+  t1 = statsNow();
+  mappedTree = getMSTprimCSR(&snapshot->csr, 0);
+  t2 = statsNow();
+  status |= treeWeight(parsedTree, n - 1) != treeWeight(mappedTree, n - 1);
+  printf("%24s %12.3f\n", "Prim, parsed", t1 - t0);
+  printf("%24s %12.3f\n", "Prim, mapped", t2 - t1);
+  free(parsedTree);
+  free(mappedTree);
+
+  closeSnapshot(snapshot);
+  deleteCSRGraph(parsed);
+  if (status)
+    fprintf(stderr, "the snapshot and the parsed graph disagree\n");
+  return status;
+}
+
+// phases of benchExternal, each run in its own process
+#define PHASE_WRITE 0       // write the text of a shuffled grid
+#define PHASE_MEMORY 1      // load the text into a Graph and run on it
+#define PHASE_CONVERT 2     // stream the text into a snapshot
+#define PHASE_REORDER 3     // reorder the snapshot breadth-first
+#define PHASE_MAPPED 4      // run on the mapped snapshot
+#define PHASE_REORDERED 5   // run on the mapped, reordered snapshot
+
+/*
+ * Writes a 'side' x 'side' grid with shuffled vertex IDs to the text file
+ * 'filename', and compares Dijkstra and Prim on it in memory with the same
+ * algorithms on its snapshot 'snapshotName' and on a breadth-first reordered
+ * copy. Every phase runs in a child process, and its time and peak resident
+ * set size are printed. Returns 0 iff all runs agree.
+ */
+int benchExternal(int side, const char* filename, const char* snapshotName)
+{
+  char reorderedName[1024];
+  snprintf(reorderedName, sizeof(reorderedName), "%s.bfs", snapshotName);
+  const char* names[3] = { filename, snapshotName, reorderedName };
+
+  printf("%24s %10s %10s\n", "phase", "seconds", "peak MB");
+  if (measurePhase("write text", PHASE_WRITE, side, names) < 0
+      || measurePhase("convert to snapshot", PHASE_CONVERT, side, names) < 0
+      || measurePhase("reorder snapshot", PHASE_REORDER, side, names) < 0)
+    return 1;
+  long long inMemory = measurePhase("in memory", PHASE_MEMORY, side, names);
+  long long mapped = measurePhase("mapped", PHASE_MAPPED, side, names);
+  long long reordered = measurePhase("mapped, reordered", PHASE_REORDERED,
+                                     side, names);
+
+  int status = inMemory < 0 || mapped != inMemory || reordered != inMemory;
+  if (status)
+    fprintf(stderr, "the runs disagree\n");
+  return status;
+}
+
+/*
+ * Runs phase 'phase' of benchExternal on a 'side' x 'side' grid with the
+ * text file, snapshot and reordered snapshot 'names'. For the phases that
+ * run the algorithms, returns the sum of the distances from the vertex
+ * with original ID 0 plus the weight of Prim's tree from it; otherwise 0.
+ * Returns -1 on failure.
+ */
+long long externalPhase(int phase, int side, const char* names[3])
+{
+  if (phase == PHASE_WRITE)
+  {
+    Graph* graph = gridGraph(side, 100, 42);
+    int* newIds = randomPermutation(graph->numVertices, 7);
+    bool written = writeGraphText(graph, names[0], newIds);
+    free(newIds);
+    deleteGraph(graph);
+    return written ? 0 : -1;
+  }
+  if (phase == PHASE_CONVERT)
+    return convertGraphToSnapshot(names[0], names[1]) ? 0 : -1;
+
+  if (phase == PHASE_MEMORY)
+  {
+    Graph* graph = loadArenaGraph(names[0]);
+    if (graph == NULL)
+      return -1;
+    Edge* tree = getDistanceTreeDijkstra(graph, 0);
+    Edge* mst = getMSTprim(graph, 0);
+    long long result = sumDistances(tree, graph->numVertices)
+                       + treeWeight(mst, graph->numVertices - 1);
+    free(tree);
+    free(mst);
+    deleteGraph(graph);
+    return result;
+  }
+
+  GraphSnapshot* snapshot = openSnapshot(
+      phase == PHASE_REORDERED ? names[2] : names[1], false);
+  if (snapshot == NULL)
+    return -1;
+  long long result = 0;
+  if (phase == PHASE_REORDER)
+    result = reorderSnapshot(snapshot, names[2]) ? 0 : -1;
+  else
+  {
+    int n = snapshot->csr.numVertices;
+    int start = findSnapshotVertex(snapshot, 0);
+    Edge* tree = getDistanceTreeDijkstraCSR(&snapshot->csr, start);
+    Edge* mst = getMSTprimCSR(&snapshot->csr, start);
+    result = sumDistances(tree, n) + treeWeight(mst, n - 1);
+    free(tree);
+    free(mst);
+  }
+  closeSnapshot(snapshot);
+  return result;
+}
+
+/*
+ * Runs externalPhase in a child process, so that it has a peak resident set
+ * size of its own, and prints 'name' with its time and peak RSS. Returns
+ * the result of the phase, or -1 if the child could not be run.
+ */
+long long measurePhase(const char* name, int phase, int side,
+                       const char* names[3])
+{
+  int fds[2];
+  if (pipe(fds) != 0)
+    return -1;
+
+  double t0 = statsNow();
+  pid_t pid = fork();
+  if (pid == 0)
+  {
+    long long result = externalPhase(phase, side, names);
+    ssize_t written = write(fds[1], &result, sizeof(result));
+    _exit(written == sizeof(result) ? 0 : 1);
+  }
+  close(fds[1]);
+
+  long long result = -1;
+  if (pid < 0 || read(fds[0], &result, sizeof(result)) != sizeof(result))
+    result = -1;
+  close(fds[0]);
+
+  struct rusage usage;
+  int status;
+  if (pid > 0 && wait4(pid, &status, 0, &usage) == pid)
+    printf("%24s %10.2f %10ld\n", name, statsNow() - t0,
+           usage.ru_maxrss / 1024);
+  return result;
+}
+
+/*
+ * Applies 'reps' batches of random weight changes of every size from 1 to
+ * 10000 undirected edges to a 'side' x 'side' grid with weights in
+ * [1, 100], repairing the distance tree from vertex 0 with
+ * updateDistanceTree after each batch and timing it against a fresh
+ * getDistanceTreeDijkstra. Prints the mean time of both and the mean
+ * number of repaired vertices per batch size. Returns 0 iff every repaired
+ * tree has the distances of the recomputed one.
+ */
+int benchRepair(int side, int reps)
+{
+  static const int batchSizes[] = {1, 10, 100, 1000, 10000};
+  int numSizes = sizeof(batchSizes) / sizeof(batchSizes[0]);
+  int maxBatch = batchSizes[numSizes - 1];
+
+  Graph* graph = gridGraph(side, 100, 42);
+  Edge* tree = getDistanceTreeDijkstra(graph, 0);
+  DynamicSSSP* sssp = newDynamicSSSP(graph, NULL, tree, 0);
+  EdgeUpdate* updates =
+      (EdgeUpdate*) malloc(2 * maxBatch * sizeof(EdgeUpdate));
+  unsigned state = 7;
+  int status = 0;
+
+  printf("Distance tree of a %d x %d grid after a batch of edge changes, "
+         "mean of %d batches\n", side, side, reps);
+  printf("%10s %12s %12s %10s %12s\n", "edges", "repair ms", "recompute ms",
+         "speedup", "repaired");
+  for (int i = 0; i < numSizes; i++)
+  {
+    double repair = 0, recompute = 0;
+    long long repaired = 0;
+    for (int r = 0; r < reps; r++)
+    {
+      /* Both directions of an undirected edge get the same new weight. */
+      for (int k = 0; k < batchSizes[i]; k++)
+      {
+        Edge* edge = randomEdge(graph, &state)->edge;
+        dist_t weight = 1 + nextRandom(&state) % 100;
+        EdgeUpdate forward = {edge->fromVertex, edge->toVertex, weight};
+        EdgeUpdate backward = {edge->toVertex, edge->fromVertex, weight};
+        updates[2 * k] = forward;
+        updates[2 * k + 1] = backward;
+      }
+
+      double t0 = statsNow();
+      repaired += updateDistanceTree(sssp, updates, 2 * batchSizes[i]);
+      double t1 = statsNow();
+      Edge* reference = getDistanceTreeDijkstra(graph, 0);
+      double t2 = statsNow();
+
+      if (!sameDistances(reference, tree, graph->numVertices))
+      {
+        fprintf(stderr, "batch of %d edges: repaired tree is wrong\n",
+                batchSizes[i]);
+        status = 1;
+      }
+      free(reference);
+      repair += t1 - t0;
+      recompute += t2 - t1;
+    }
+    printf("%10d %12.3f %12.3f %10.1f %12lld\n", batchSizes[i],
+           repair * 1000 / reps, recompute * 1000 / reps, recompute / repair,
+           repaired / reps);
+  }
+
+  free(updates);
+  deleteDynamicSSSP(sssp);
+  free(tree);
+  deleteGraph(graph);
+  return status;
+}
+
+/*
+ * Returns the adjacency list node of a random edge of 'graph', drawn from
+ * the edges of a random vertex with at least one edge, advancing 'state'.
+ * Precondition: 'graph' has at least one edge
+ */
+EdgeList* randomEdge(Graph* graph, unsigned* state)
+{
+  while (true)
+  {
+    int id = nextRandom(state) % graph->numVertices;
+    int degree = 0;
+    for (EdgeList* l = graph->vertices[id]->adjList; l != NULL; l = l->next)
+      degree++;
+    if (degree == 0)
+      continue;
+
+    EdgeList* l = graph->vertices[id]->adjList;
+    for (int skip = nextRandom(state) % degree; skip > 0; skip--)
+      l = l->next;
+    return l;
+  }
+}
+
+/*
+ * Applies 'numUpdates' random changes to a 'side' x 'side' grid with
+ * weights in [1, 100], alternating between reweighting an edge, and
+ * deleting an edge and inserting it again with a new weight, and keeps its
+ * MST up to date with a DynamicMST. Prints the mean time of every kind of
+ * update against rerunning getMSTprim. Returns 0 iff the final weight of
+ * the DynamicMST is that of getMSTprim.
+ */
+int benchDynamicMST(int side, int numUpdates)
+{
+  static const char* names[] = {"reweightMSTEdge", "deleteMSTEdge",
+                                "insertMSTEdge"};
+  Graph* graph = gridGraph(side, 100, 42);
+  int n = graph->numVertices;
+
+  double t0 = statsNow();
+  Edge* mst = getMSTprim(graph, 0);
+  double t1 = statsNow();
+  DynamicMST* dyn = newDynamicMST(graph, mst, n - 1);
+  double t2 = statsNow();
+  free(mst);
+
+  /* time and count of reweights, deletions and insertions */
+  double seconds[3] = {0, 0, 0};
+  int counts[3] = {0, 0, 0};
+  unsigned state = 7;
+  for (int i = 0; i < numUpdates; i++)
+  {
+    Edge* edge = randomEdge(graph, &state)->edge;
+    int u = edge->fromVertex, v = edge->toVertex;
+    dist_t weight = 1 + nextRandom(&state) % 100;
+    setUndirectedWeight(graph, edge, weight);
+
+    double start = statsNow();
+    if (i % 2 == 0)
+    {
+      reweightMSTEdge(dyn, u, v, weight);
+      seconds[0] += statsNow() - start;
+      counts[0]++;
+    }
+    else
+    {
+      deleteMSTEdge(dyn, u, v);
+      double middle = statsNow();
+      insertMSTEdge(dyn, u, v, weight);
+      seconds[1] += middle - start;
+      seconds[2] += statsNow() - middle;
+      counts[1]++;
+      counts[2]++;
+    }
+  }
+
+  double t3 = statsNow();
+  mst = getMSTprim(graph, 0);
+  double t4 = statsNow();
+  long long expected = treeWeight(mst, n - 1);
+  free(mst);
+
+  printf("MST of a %d x %d grid under %d random updates\n", side, side,
+         numUpdates);
+  printf("%24s %12.3f ms\n", "getMSTprim", (t1 - t0 + t4 - t3) / 2 * 1000);
+  printf("%24s %12.3f ms\n", "newDynamicMST", (t2 - t1) * 1000);
+  for (int k = 0; k < 3; k++)
+    printf("%24s %12.3f us\n", names[k],
+           counts[k] ? seconds[k] / counts[k] * 1e6 : 0);
+  printf("%24s %12lld (getMSTprim %lld)\n", "weight", dynamicMSTWeight(dyn),
+         expected);
+
+  int status = dynamicMSTWeight(dyn) != expected;
+  deleteDynamicMST(dyn);
+  deleteGraph(graph);
+  return status;
+}
+
+/*
+ * Sets the weight of 'edge' of the undirected Graph 'graph', and of its
+ * opposite edge, to 'weight'.
+ */
+void setUndirectedWeight(Graph* graph, Edge* edge, dist_t weight)
+{
+  edge->weight = weight;
+  for (EdgeList* l = graph->vertices[edge->toVertex]->adjList; l != NULL;
+       l = l->next)
+    if (l->edge->toVertex == edge->fromVertex)
+      l->edge->weight = weight;
+}
+
+/*
+ * Computes the distance trees from 'numSources' random vertices of a
+ * 'side' x 'side' grid with weights in [1, 100] with getDistanceTreeDijkstra,
+ * then with getDistanceTreesBatch on 1, 2, 4, ... 'maxThreads' threads, and
+ * prints the time, throughput, speedup and steals of every thread count.
+ * Returns 0 iff every batch wrote all trees with the right distances.
+ */
+int benchBatch(int side, int numSources, int maxThreads)
+{
+  Graph* graph = gridGraph(side, 100, 42);
+  int n = graph->numVertices;
+  int* sources = (int*) malloc(numSources * sizeof(int));
+  Edge** reference = (Edge**) malloc(numSources * sizeof(Edge*));
+  Edge** trees = (Edge**) malloc(numSources * sizeof(Edge*));
+  unsigned state = 11;
+  int status = 0;
+
+  double start = statsNow();
+  for (int i = 0; i < numSources; i++)
+  {
+    sources[i] = nextRandom(&state) % n;
+    reference[i] = getDistanceTreeDijkstra(graph, sources[i]);
+  }
+  double sequential = statsNow() - start;
+  for (int i = 0; i < numSources; i++)
+    trees[i] = (Edge*) malloc(n * sizeof(Edge));
+
+  printf("%d distance trees on a %d x %d grid\n", numSources, side, side);
+  printf("%10s %10.2f ms %10.1f trees/s\n", "sequential", sequential * 1000,
+         numSources / sequential);
+  printf("%10s %10s %10s %10s %10s\n", "threads", "ms", "trees/s",
+         "speedup", "steals");
+
+  double single = -1;
+  for (int threads = 1; threads <= maxThreads; threads *= 2)
+  {
+    QueryPool* pool = newQueryPool(threads);
+    start = statsNow();
+    int written = getDistanceTreesBatch(pool, graph, sources, numSources,
+                                        trees);
+    double elapsed = statsNow() - start;
+
+    bool same = written == numSources;
+    for (int i = 0; i < numSources && same; i++)
+      same = sameDistances(reference[i], trees[i], n)
+             && trees[i][sources[i]].toVertex == sources[i];
+    if (!same)
+    {
+      fprintf(stderr, "batch on %d threads computed wrong distances\n",
+              threads);
+      status = 1;
+    }
+
+    if (single < 0)
+      single = elapsed;
+    printf("%10d %10.2f %10.1f %10.2f %10d\n", threads, elapsed * 1000,
+           numSources / elapsed, single / elapsed, queryPoolSteals(pool));
+    deleteQueryPool(pool);
+  }
+
+  for (int i = 0; i < numSources; i++)
+  {
+    free(reference[i]);
+    free(trees[i]);
+  }
+  free(reference);
+  free(trees);
+  free(sources);
+  deleteGraph(graph);
+  return status;
+}
+
+/*
+ * Computes the distance table between 'numSources' and 'numTargets' random
+ * vertices of a 'side' x 'side' grid with weights in [1, 100] with one full
+ * Dijkstra search per source, then with getDistanceTable and, after
+ * building a Contraction Hierarchy, getDistanceTableCH on 1, 2, 4, ...
+ * 'maxThreads' threads. Prints the time of every method and thread count.
+ * Returns 0 iff all tables agree.
+ */
+int benchTable(int side, int numSources, int numTargets, int maxThreads)
+{
+  Graph* graph = gridGraph(side, 100, 42);
+  int n = graph->numVertices;
+  int* sources = (int*) malloc(numSources * sizeof(int));
+  int* targets = (int*) malloc(numTargets * sizeof(int));
+  unsigned state = 13;
+  int status = 0;
+  for (int i = 0; i < numSources; i++)
+    sources[i] = nextRandom(&state) % n;
+  for (int j = 0; j < numTargets; j++)
+    targets[j] = nextRandom(&state) % n;
+
+  size_t cells = (size_t) numSources * numTargets;
+  dist_t* reference = (dist_t*) malloc(cells * sizeof(dist_t));
+  Workspace* ws = newWorkspace(n);
+  double start = statsNow();
+  for (int i = 0; i < numSources; i++)
+  {
+    searchDijkstra(ws, graph, sources[i], NOTHING, DIST_MAX);
+    for (int j = 0; j < numTargets; j++)
+      reference[(size_t) i * numTargets + j] = wsDistance(ws, targets[j]);
+  }
+  double full = statsNow() - start;
+  deleteWorkspace(ws);
+
+  start = statsNow();
+  ContractionHierarchy* ch = newContractionHierarchy(graph);
+  double preprocess = statsNow() - start;
+
+  printf("%d x %d distance table on a %d x %d grid\n", numSources,
+         numTargets, side, side);
+  printf("%24s %10.2f ms\n", "full Dijkstra per source", full * 1000);
+  printf("%24s %10.2f ms\n", "CH preprocessing", preprocess * 1000);
+  printf("%10s %14s %14s\n", "threads", "dijkstra ms", "ch buckets ms");
+
+  for (int threads = 1; threads <= maxThreads; threads *= 2)
+  {
+    ThreadTeam* team = newThreadTeam(threads);
+    start = statsNow();
+    dist_t* table = getDistanceTableTeam(graph, sources, numSources, targets,
+                                         numTargets, team);
+    double mid = statsNow();
+    dist_t* tableCH = getDistanceTableCHTeam(ch, sources, numSources,
+                                             targets, numTargets, team);
+    double end = statsNow();
+    deleteThreadTeam(team);
+
+    if (memcmp(table, reference, cells * sizeof(dist_t)) != 0
+        || memcmp(tableCH, reference, cells * sizeof(dist_t)) != 0)
+    {
+      fprintf(stderr, "distance tables on %d threads are wrong\n", threads);
+      status = 1;
+    }
+    printf("%10d %14.2f %14.2f\n", threads, (mid - start) * 1000,
+           (end - mid) * 1000);
+    free(table);
+    free(tableCH);
+  }
+
+  free(reference);
+  deleteContractionHierarchy(ch);
+  free(sources);
+  free(targets);
+  deleteGraph(graph);
+  return status;
+}
+
+/*
+ * Runs 'numQueries' path queries on a 'side' x 'side' grid with weights in
+ * [1, 100], 90% of them from one of 'numHot' random sources and the rest
+ * from any vertex, to random targets. Halfway through, the weight of a
+ * random edge triples and the cache is invalidated. Times the queries
+ * with a Dijkstra run each and with a TreeCache of 'budgetMB' MB under
+ * either policy, and prints the cache counters. Returns 0 iff all paths
+ * have the distance Dijkstra's algorithm finds.
+ */
+int benchCache(int side, int numHot, int numQueries, int budgetMB)
+{
+  static const char* names[] = {"lru", "lfu"};
+  Graph* graph = gridGraph(side, 100, 42);
+  int n = graph->numVertices;
+  unsigned state = 17;
+  int status = 0;
+
+  int* hot = (int*) malloc((numHot > 0 ? numHot : 1) * sizeof(int));
+  for (int i = 0; i < numHot; i++)
+    hot[i] = nextRandom(&state) % n;
+  int* sources = (int*) malloc(numQueries * sizeof(int));
+  int* targets = (int*) malloc(numQueries * sizeof(int));
+  for (int q = 0; q < numQueries; q++)
+  {
+    bool fromHot = numHot > 0 && nextRandom(&state) % 10 != 0;
+    sources[q] = fromHot ? hot[nextRandom(&state) % numHot]
+                         : (int) (nextRandom(&state) % n);
+    targets[q] = nextRandom(&state) % n;
+  }
+  Edge* changed = randomEdge(graph, &state)->edge;
+  dist_t oldWeight = changed->weight;
+
+  /* Without a cache, keeping the distances to check the cached runs. */
+  dist_t* expected = (dist_t*) malloc(numQueries * sizeof(dist_t));
+  Workspace* ws = newWorkspace(n);
+  Edge* tree = (Edge*) malloc(n * sizeof(Edge));
+  double start = statsNow();
+  for (int q = 0; q < numQueries; q++)
+  {
+    if (q == numQueries / 2)
+      setUndirectedWeight(graph, changed, 3 * oldWeight);
+    fillDistanceTreeWS(ws, graph, sources[q], tree);
+    EdgeList* path = pathToEdgeList(tree, sources[q], targets[q]);
+    expected[q] = tree[targets[q]].weight;
+    deleteEdgeList(path);
+  }
+  double uncached = statsNow() - start;
+  setUndirectedWeight(graph, changed, oldWeight);
+  free(tree);
+  deleteWorkspace(ws);
+
+  printf("%d queries on a %d x %d grid, 90%% from %d hot sources, "
+         "%d MB cache\n", numQueries, side, side, numHot, budgetMB);
+  printf("%10s %10.2f ms\n", "no cache", uncached * 1000);
+
+  for (int policy = CACHE_LRU; policy <= CACHE_LFU; policy++)
+  {
+    TreeCache* cache = newTreeCache(graph, (size_t) budgetMB << 20, policy);
+    start = statsNow();
+    for (int q = 0; q < numQueries; q++)
+    {
+      if (q == numQueries / 2)
+      {
+        setUndirectedWeight(graph, changed, 3 * oldWeight);
+        invalidateTreeCache(cache);
+      }
+      EdgeList* path = getCachedPath(cache, sources[q], targets[q]);
+      if (pathWeight(path) != expected[q])
+      {
+        fprintf(stderr, "%s cache query %d returned a wrong path\n",
+                names[policy], q);
+        status = 1;
+      }
+      deleteEdgeList(path);
+    }
+    double elapsed = statsNow() - start;
+    setUndirectedWeight(graph, changed, oldWeight);
+
+    printf("%10s %10.2f ms %10.2fx\n", names[policy], elapsed * 1000,
+           uncached / elapsed);
+    printTreeCacheStats(cache);
+    deleteTreeCache(cache);
+  }
+
+  free(expected);
+  free(sources);
+  free(targets);
+  free(hot);
+  deleteGraph(graph);
+  return status;
+}
+
+/*
+ * Runs timeOrders on a 'side' x 'side' grid with weights in [1, 100] whose
+ * vertex IDs are shuffled, as if read from an unordered file, and on an
+ * R-MAT graph of 2^scale vertices. Returns 0 iff all orders produced the
+ * same results.
+ */
+int benchReorder(int side, int scale, int reps)
+{
+  Graph* grid = gridGraph(side, 100, 42);
+  Permutation shuffle;
+  shuffle.numVertices = grid->numVertices;
+  shuffle.newId = randomPermutation(grid->numVertices, 7);
+  shuffle.oldId = (int*) malloc(grid->numVertices * sizeof(int));
+  for (int v = 0; v < grid->numVertices; v++)
+    shuffle.oldId[shuffle.newId[v]] = v;
+  Graph* shuffled = permuteGraph(grid, &shuffle);
+  free(shuffle.newId);
+  free(shuffle.oldId);
+  deleteGraph(grid);
+
+  char name[64];
+  snprintf(name, sizeof(name), "shuffled %d x %d grid", side, side);
+  int status = timeOrders(name, shuffled, reps);
+  deleteGraph(shuffled);
+
+  Graph* rmat = rmatGraph(scale, 16, 100, 42);
+  snprintf(name, sizeof(name), "R-MAT graph, scale %d", scale);
+  status |= timeOrders(name, rmat, reps);
+  deleteGraph(rmat);
+  return status;
+}
+
+/*
+ * Renumbers the vertices of 'graph' in every order of reorder.h and times
+ * getDistanceTreeDijkstra, getDistanceTreeDijkstraCSR and getMSTprim from
+ * original vertex 0 on the result (best of 'reps' runs), next to the time
+ * of the renumbering and the average ID distance between the endpoints of
+ * an edge. Returns 0 iff every order gives the same distances, mapped back
+ * to original IDs, and the same MST weight.
+ */
+int timeOrders(const char* name, Graph* graph, int reps)
+{
+  static const int kinds[] = {NOTHING, ORDER_BFS, ORDER_RCM, ORDER_DEGREE};
+  static const char* kindNames[] = {"as loaded", "bfs", "rcm", "degree"};
+  int n = graph->numVertices;
+  int status = 0;
+
+  Edge* reference = getDistanceTreeDijkstra(graph, 0);
+  Edge* mst = getMSTprim(graph, 0);
+  long long mstWeight = treeWeight(mst, n - 1);
+  free(mst);
+
+  printf("%s: %d vertices, %d edges, best of %d runs\n", name, n,
+         graph->numEdges, reps);
+  printf("%10s %10s %10s %12s %12s %10s\n", "order", "prep ms", "edge span",
+         "dijkstra ms", "csr ms", "prim ms");
+  for (int k = 0; k < 4; k++)
+  {
+    double start = statsNow();
+    Permutation* perm = NULL;
+    Graph* local = graph;
+    if (kinds[k] != NOTHING)
+    {
+      CSRGraph* csr = csrFromGraph(graph);
+      perm = getVertexOrder(csr, kinds[k]);
+      local = permuteGraph(graph, perm);
+      deleteCSRGraph(csr);
+    }
+    double prep = statsNow() - start;
+    CSRGraph* localCSR = csrFromGraph(local);
+    int source = perm ? perm->newId[0] : 0;
+
+    double dijkstra = -1, dijkstraCSR = -1, prim = -1;
+    for (int r = 0; r < reps; r++)
+    {
+      start = statsNow();
+      Edge* tree = getDistanceTreeDijkstra(local, source);
+      double mid = statsNow();
+      Edge* treeCSR = getDistanceTreeDijkstraCSR(localCSR, source);
+      double end = statsNow();
+      mst = getMSTprim(local, source);
+      double elapsed = statsNow() - end;
+      if (dijkstra < 0 || mid - start < dijkstra)
+        dijkstra = mid - start;
+      if (dijkstraCSR < 0 || end - mid < dijkstraCSR)
+        dijkstraCSR = end - mid;
+      if (prim < 0 || elapsed < prim)
+        prim = elapsed;
+
+      Edge* restored = perm ? restoreDistanceTree(tree, perm) : NULL;
+      Edge* restoredCSR = perm ? restoreDistanceTree(treeCSR, perm) : NULL;
+      if (!sameDistances(reference, restored ? restored : tree, n)
+          || !sameDistances(reference, restoredCSR ? restoredCSR : treeCSR, n)
+          || treeWeight(mst, n - 1) != mstWeight)
+      {
+        fprintf(stderr, "%s order computed wrong results\n", kindNames[k]);
+        status = 1;
+      }
+      free(restored);
+      free(restoredCSR);
+      free(tree);
+      free(treeCSR);
+      free(mst);
+    }
+
+    printf("%10s %10.2f %10.0f %12.2f %12.2f %10.2f\n", kindNames[k],
+           prep * 1000, averageEdgeSpan(local), dijkstra * 1000,
+           dijkstraCSR * 1000, prim * 1000);
+    deleteCSRGraph(localCSR);
+    if (perm)
+    {
+      deleteGraph(local);
+      deletePermutation(perm);
+    }
+  }
+
+  free(reference);
+  return status;
+}
+
+/*
+ * Returns the average of |u - v| over all edges u -> v of 'graph'.
+ */
+double averageEdgeSpan(Graph* graph)
+{
+  long long total = 0;
+  for (int u = 0; u < graph->numVertices; u++)
+    for (EdgeList* l = graph->vertices[u]->adjList; l != NULL; l = l->next)
+      total += llabs((long long) l->edge->toVertex - u);
+  return graph->numEdges ? (double) total / graph->numEdges : 0;
+}
+
+/*
+ * Prints the sizes of Edge, HeapNode and the per-vertex arrays of
+ * Dijkstra's algorithm for the dist_t of this build, then times
+ * getDistanceTreeDijkstra and its CSR version on a 'side' x 'side' grid
+ * (best of 'reps' runs) and prints the peak resident set size. Finally
+ * runs Dijkstra along a path of 3 edges of weight 10^9. Returns 0 iff the
+ * two versions agree and the path's end is at distance 3 * 10^9, or
+ * unreachable when dist_t cannot hold it.
+ */
+int benchMemory(int side, int reps)
+{
+  /* Records: finished, predecessors, distances, tree and the MinHeap. */
+  size_t perVertex = sizeof(bool) + sizeof(int) + sizeof(dist_t)
+                     + sizeof(Edge) + sizeof(HeapNode) + sizeof(int);
+  printf("DIST_BITS %d\n", DIST_BITS);
+  printf("%24s %10zu\n", "Edge bytes", sizeof(Edge));
+  printf("%24s %10zu\n", "EdgeList bytes", sizeof(EdgeList));
+  printf("%24s %10zu\n", "HeapNode bytes", sizeof(HeapNode));
+  printf("%24s %10zu\n", "Dijkstra bytes / vertex", perVertex);
+
+  Graph* graph = gridGraph(side, 100, 42);
+  int n = graph->numVertices;
+  long long numEdges = 0;
+  for (int id = 0; id < n; id++)
+    for (EdgeList* l = graph->vertices[id]->adjList; l != NULL; l = l->next)
+      numEdges++;
+  CSRGraph* csr = csrFromGraph(graph);
+  printf("%24s %10.1f\n", "Graph MB",
+         (n * (sizeof(Vertex) + sizeof(Vertex*))
+          + numEdges * (sizeof(Edge) + sizeof(EdgeList))) / 1e6);
+  printf("%24s %10.1f\n", "Dijkstra MB", (double) n * perVertex / 1e6);
+
+  int status = 0;
+  double best[2] = {-1, -1};
+  for (int r = 0; r < reps; r++)
+  {
+    double t0 = statsNow();
+    Edge* tree = getDistanceTreeDijkstra(graph, 0);
+    double t1 = statsNow();
+    Edge* treeCSR = getDistanceTreeDijkstraCSR(csr, 0);
+    double t2 = statsNow();
+
+    if (!sameDistances(tree, treeCSR, n))
+      status = 1;
+    if (best[0] < 0 || t1 - t0 < best[0])
+      best[0] = t1 - t0;
+    if (best[1] < 0 || t2 - t1 < best[1])
+      best[1] = t2 - t1;
+    free(tree);
+    free(treeCSR);
+  }
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  printf("Dijkstra on a %d x %d grid, best of %d runs (ms)\n", side, side,
+         reps);
+  printf("%24s %10.2f\n", "Graph", best[0] * 1000);
+  printf("%24s %10.2f\n", "CSR", best[1] * 1000);
+  printf("%24s %10ld\n", "peak RSS MB", usage.ru_maxrss / 1024);
+  deleteCSRGraph(csr);
+  deleteGraph(graph);
+
+  Graph* path = newGraph(4);
+  for (int id = 0; id < 4; id++)
+    path->vertices[id] = newVertex(id, NULL, NULL);
+  for (int id = 0; id < 3; id++)
+    path->vertices[id]->adjList = newEdgeList(newEdge(id, id + 1, 1000000000),
+                                              NULL);
+  Edge* tree = getDistanceTreeDijkstra(path, 0);
+  bool reached = tree[3].toVertex != NOTHING;
+  if (reached)
+    printf("%24s %10" PRIdist "\n", "3 * 10^9 away", tree[3].weight);
+  else
+    printf("%24s %10s\n", "3 * 10^9 away", "unreachable");
+  if (reached != (DIST_MAX >= 3000000000LL)
+      || (reached && tree[3].weight != 3 * tree[1].weight))
+    status = 1;
+  free(tree);
+  deleteGraph(path);
+  return status;
+}
+
+// graphs of the suite, for 'all'
+#define NUM_SUITE_GRAPHS 4
+#define SUITE_EDGE_FACTOR 16    // undirected edges per vertex of rmat graphs
+#define SUITE_DEGREE 8          // average degree of er and geometric graphs
+
+/*
+ * Generates the suite graph 'kind' (or every graph if 'kind' is "all") at
+ * scale 'scale', writes it to a temporary input file, and then 'reps'
+ * times loads the file and runs getMSTprim, getDistanceTreeDijkstra and
+ * getShortestPaths from a random source on it, timing each separately. The
+ * file is removed after the runs.
+ * Prints the percentiles of every operation to stdout in 'format', json or
+ * csv, and the progress to stderr. Returns 0 iff all runs succeeded.
+ */
+int benchSuite(const char* kind, int scale, int reps, const char* format)
+{
+  static const char* kinds[NUM_SUITE_GRAPHS] = { "rmat", "grid", "er",
+                                                 "geometric" };
+  static const char* operations[4] = { "load", "getMSTprim",
+                                       "getDistanceTreeDijkstra",
+                                       "getShortestPaths" };
+  bool json = strcmp(format, "json") == 0;
+  if (!json && strcmp(format, "csv") != 0)
+  {
+    fprintf(stderr, "Unknown format: %s\n", format);
+    return 1;
+  }
+  if (reps < 1 || scale < 1 || scale > 26)
+  {
+    fprintf(stderr, "Need reps >= 1 and 1 <= scale <= 26\n");
+    return 1;
+  }
+
+  double* seconds = (double*) malloc(4 * reps * sizeof(double));
+  bool first = true;
+  int status = 0;
+  if (json)
+    printf("[\n");
+  for (int k = 0; k < NUM_SUITE_GRAPHS; k++)
+  {
+    if (strcmp(kind, "all") != 0 && strcmp(kind, kinds[k]) != 0)
+      continue;
+
+    double t0 = statsNow();
+    Graph* graph = suiteGraph(kinds[k], scale);
+    double t1 = statsNow();
+    char filename[64];
+    snprintf(filename, sizeof(filename), "/tmp/suite_%s_%d_XXXXXX", kinds[k],
+             scale);
+    int fd = mkstemp(filename);
+    if (fd < 0 || close(fd) != 0 || !writeGraphText(graph, filename, NULL))
+    {
+      fprintf(stderr, "cannot write %s\n", filename);
+      if (fd >= 0)
+        unlink(filename);
+      deleteGraph(graph);
+      status = 1;
+      continue;
+    }
+    fprintf(stderr, "%s: %d vertices, %d edges, generated in %.2f s\n",
+            kinds[k], graph->numVertices, graph->numEdges, t1 - t0);
+
+    unsigned state = 42;
+    for (int rep = 0; rep < reps; rep++)
+    {
+      double t[5];
+      t[0] = statsNow();
+      Graph* loaded = loadArenaGraph(filename);
+      t[1] = statsNow();
+      if (loaded == NULL)
+      {
+        status = 1;
+        break;
+      }
+      int n = loaded->numVertices;
+      int source = nextRandom(&state) % n;
+      Edge* mst = getMSTprim(loaded, source);
+      t[2] = statsNow();
+      Edge* tree = getDistanceTreeDijkstra(loaded, source);
+      t[3] = statsNow();
+      EdgeList** paths = getShortestPaths(tree, n, source);
+      t[4] = statsNow();
+
+      for (int op = 0; op < 4; op++)
+        seconds[op * reps + rep] = t[op + 1] - t[op];
+      for (int id = 0; id < n; id++)
+        deleteEdgeList(paths[id]);
+      free(paths);
+      free(tree);
+      free(mst);
+      deleteGraph(loaded);
+    }
+    unlink(filename);
+
+    for (int op = 0; status == 0 && op < 4; op++)
+    {
+      printSuiteRow(format, first, kinds[k], scale, graph, operations[op],
+                    seconds + op * reps, reps);
+      first = false;
+    }
+    deleteGraph(graph);
+  }
+  if (json)
+    printf("\n]\n");
+  free(seconds);
+
+  if (first && status == 0)
+  {
+    fprintf(stderr, "Unknown graph: %s\n", kind);
+    return 1;
+  }
+  return status;
+}
+
+/*
+ * Returns the suite graph 'kind' at scale 'scale': 2^scale vertices (the
+ * nearest square for grids) with weights in [1, 100].
+ */
+Graph* suiteGraph(const char* kind, int scale)
+{
+  int n = 1 << scale;
+  if (strcmp(kind, "rmat") == 0)
+    return rmatGraph(scale, SUITE_EDGE_FACTOR, 100, 42);
+  if (strcmp(kind, "grid") == 0)
+    return gridGraph((int) (sqrt(n) + 0.5), 100, 42);
+  if (strcmp(kind, "er") == 0)
+    return erdosRenyiGraph(n, SUITE_DEGREE, 100, 42);
+  return geometricGraph(n, SUITE_DEGREE, 100, 42);
+}
+
+/*
+ * Prints the minimum, mean, median, 90th and 99th percentile and maximum of
+ * the 'reps' times in 'seconds', which are sorted in place, in milliseconds
+ * as one row in 'format' (json or csv) for 'operation' on 'graph', the
+ * suite graph 'kind' at scale 'scale'. 'first' is true for the first row.
+ */
+void printSuiteRow(const char* format, bool first, const char* kind,
+                   int scale, Graph* graph, const char* operation,
+                   double* seconds, int reps)
+{
+  double mean = 0;
+  for (int i = 0; i < reps; i++)
+    mean += seconds[i] / reps;
+  for (int i = 1; i < reps; i++)
+    for (int j = i; j > 0 && seconds[j - 1] > seconds[j]; j--)
+    {
+      double swap = seconds[j];
+      seconds[j] = seconds[j - 1];
+      seconds[j - 1] = swap;
+    }
+
+  if (strcmp(format, "json") == 0)
+    printf("%s  {\"graph\": \"%s\", \"scale\": %d, \"vertices\": %d, "
+           "\"edges\": %d, \"operation\": \"%s\", \"runs\": %d, "
+           "\"min_ms\": %.3f, \"mean_ms\": %.3f, \"p50_ms\": %.3f, "
+           "\"p90_ms\": %.3f, \"p99_ms\": %.3f, \"max_ms\": %.3f}",
+           first ? "" : ",\n", kind, scale, graph->numVertices,
+           graph->numEdges, operation, reps, seconds[0] * 1000, mean * 1000,
+           percentile(seconds, reps, 50) * 1000,
+           percentile(seconds, reps, 90) * 1000,
+           percentile(seconds, reps, 99) * 1000, seconds[reps - 1] * 1000);
+  else
+  {
+    if (first)
+      printf("graph,scale,vertices,edges,operation,runs,min_ms,mean_ms,"
+             "p50_ms,p90_ms,p99_ms,max_ms\n");
+    printf("%s,%d,%d,%d,%s,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n", kind, scale,
+           graph->numVertices, graph->numEdges, operation, reps,
+           seconds[0] * 1000, mean * 1000,
+           percentile(seconds, reps, 50) * 1000,
+           percentile(seconds, reps, 90) * 1000,
+           percentile(seconds, reps, 99) * 1000, seconds[reps - 1] * 1000);
+  }
+}
+
+/*
+ * Returns true iff distance trees 'tree1' and 'tree2' on 'numVertices'
+ * vertices have the same distances.
+ */
+bool sameDistances(Edge* tree1, Edge* tree2, int numVertices)
+{
+  for (int id = 0; id < numVertices; id++)
+    if (tree1[id].weight != tree2[id].weight)
+      return false;
+  return true;
+}
+
+/*
+ * Returns a hash of the vertices and adjacency lists of 'graph', in order.
+ */
+unsigned long long graphChecksum(Graph* graph)
+{
+  unsigned long long hash = 14695981039346656037ULL;   // FNV-1a
+  hash = (hash ^ (unsigned) graph->numVertices) * 1099511628211ULL;
+  hash = (hash ^ (unsigned) graph->numEdges) * 1099511628211ULL;
+  for (int id = 0; id < graph->numVertices; id++)
+  {
+    for (EdgeList* l = graph->vertices[id]->adjList; l != NULL; l = l->next)
+    {
+      hash = (hash ^ (unsigned) l->edge->toVertex) * 1099511628211ULL;
+      hash = (hash ^ (unsigned) l->edge->weight) * 1099511628211ULL;
+    }
+    hash = (hash ^ 0xffffffffU) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+/*
+ * Returns the hash graphChecksum returns for the Graph with the vertices and
+ * edges of 'csr'.
+ */
+unsigned long long csrChecksum(CSRGraph* csr)
+{
+  unsigned long long hash = 14695981039346656037ULL;
+  hash = (hash ^ (unsigned) csr->numVertices) * 1099511628211ULL;
+  hash = (hash ^ (unsigned) csr->numEdges) * 1099511628211ULL;
+  for (int v = 0; v < csr->numVertices; v++)
+  {
+    for (int e = csr->offsets[v]; e < csr->offsets[v + 1]; e++)
+    {
+      hash = (hash ^ (unsigned) csr->targets[e]) * 1099511628211ULL;
+      hash = (hash ^ (unsigned) csr->weights[e]) * 1099511628211ULL;
+    }
+    hash = (hash ^ 0xffffffffU) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+/*
+ * Writes an input file of about 'bytes' bytes to 'filename' describing a
+ * random graph in which every vertex has 'degree' outgoing edges with
+ * weights in [1, 1000]. Returns true iff successful.
+ */
+bool writeRandomGraph(const char* filename, long long bytes, int degree)
+{
+  FILE* f = fopen(filename, "w");
+  if (f == NULL)
+    return false;
+
+  /* Each edge takes about 11 bytes of text with 7-digit vertex IDs. */
+  long long numVertices = bytes / (11 * degree + 8);
+  if (numVertices < 1)
+    numVertices = 1;
+  if (numVertices > 100000000)
+    numVertices = 100000000;
+
+  unsigned state = 42;
+  fprintf(f, "%lld\n", numVertices);
+  for (long long id = 0; id < numVertices; id++)
+  {
+    fprintf(f, "%lld", id);
+    for (int i = 0; i < degree; i++)
+      fprintf(f, " %u %u", nextRandom(&state) % (unsigned) numVertices,
+              1 + nextRandom(&state) % 1000);
+    fputc('\n', f);
+  }
+  return fclose(f) == 0;
+}
+
+/*
+ * Writes 'graph' to the input file 'filename', one line per vertex, with
+ * every vertex v renamed to newIds[v] unless 'newIds' is NULL. Returns true
+ * iff successful.
+ */
+bool writeGraphText(Graph* graph, const char* filename, const int* newIds)
+{
+  FILE* f = fopen(filename, "w");
+  if (f == NULL)
+    return false;
+
+  fprintf(f, "%d\n", graph->numVertices);
+  for (int id = 0; id < graph->numVertices; id++)
+  {
+    fprintf(f, "%d", newIds ? newIds[id] : id);
+    for (EdgeList* l = graph->vertices[id]->adjList; l != NULL; l = l->next)
+    {
+      int to = l->edge->toVertex;
+      fprintf(f, " %d %" PRIdist, newIds ? newIds[to] : to,
+              l->edge->weight);
+    }
+    fputc('\n', f);
+  }
+  return fclose(f) == 0;
+}
+
+/*
+ * Returns a random permutation of 0 .. n-1.
+ */
+int* randomPermutation(int n, unsigned seed)
+{
+  int* perm = (int*) malloc(n * sizeof(int));
+  for (int i = 0; i < n; i++)
+    perm[i] = i;
+
+  unsigned state = seed ? seed : 1;
+  for (int i = n - 1; i > 0; i--)
+  {
+    int j = nextRandom(&state) % (unsigned) (i + 1);
+    int swap = perm[i];
+    perm[i] = perm[j];
+    perm[j] = swap;
+  }
+  return perm;
+}
+
+/*
+ * Returns the 'p'-th percentile of the 'count' values in 'sorted', which
+ * are in increasing order, by the nearest-rank method.
+ */
+double percentile(double* sorted, int count, double p)
+{
+  int rank = (int) ceil(p / 100 * count);
+  if (rank < 1)
+    rank = 1;
+  return sorted[rank - 1];
+}
+
+/*
+ * Returns the sum of the distances in the distance tree 'tree' on
+ * 'numVertices' vertices.
+ */
+long long sumDistances(Edge* tree, int numVertices)
+{
+  long long total = 0;
+  for (int id = 0; id < numVertices; id++)
+    total += tree[id].weight;
+  return total;
+}
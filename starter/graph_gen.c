@@ -0,0 +1,265 @@
+/*
+ * Our synthetic graph generators.
+ */
+
+#include <limits.h>
+#include <math.h>
+
+#include "graph_gen.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/*
+ * Returns a uniformly random number in [0, 1) from the xorshift generator
+ * 'state'.
+ */
+static double randomFraction(unsigned* state)
+{
+  return nextRandom (state) / 4294967296.0;
+}
+
+/*
+ * Returns a random weight in [1, maxWeight] from the xorshift generator
+ * 'state'.
+ */
+static int randomWeight(unsigned* state, int maxWeight)
+{
+  return 1 + nextRandom (state) % maxWeight;
+}
+
+/*
+ * Returns a new arena-backed graph with 'numVertices' vertices, no edges
+ * and room for about 'numEdgesHint' edges.
+ */
+static Graph* emptyGraph(int numVertices, long long numEdgesHint)
+{
+  if (numEdgesHint > INT_MAX)
+    numEdgesHint = INT_MAX;
+  Graph *graph = newArenaGraph (numVertices, numEdgesHint);
+  for (int id = 0; id < numVertices; id++)
+    graph->vertices[id] = graphNewVertex (graph, id, NULL, NULL);
+  return graph;
+}
+
+/*
+ * Returns the representative of the set of 'v' in the union-find forest
+ * 'parent', halving the path to it.
+ */
+static int findSet(int* parent, int v)
+{
+  while (parent[v] != v)
+  {
+    parent[v] = parent[parent[v]];
+    v = parent[v];
+  }
+  return v;
+}
+
+/*
+ * Makes 'graph' connected: wherever vertices v - 1 and v are not yet
+ * connected, joins them by an edge of weight 'weight'. This adds one edge
+ * per component beyond the first.
+ */
+static void connectComponents(Graph* graph, int weight)
+{
+  int n = graph->numVertices;
+  int *parent = (int *) malloc (n * sizeof (int));
+  for (int v = 0; v < n; v++)
+    parent[v] = v;
+  for (int v = 0; v < n; v++)
+    for (EdgeList *l = graph->vertices[v]->adjList; l != NULL; l = l->next)
+      parent[findSet (parent, l->edge->toVertex)] = findSet (parent, v);
+
+  for (int v = 1; v < n; v++)
+  {
+    int previous = findSet (parent, v - 1);
+    int current = findSet (parent, v);
+    if (previous != current)
+    {
+      addUndirectedEdge (graph, v - 1, v, weight);
+      parent[current] = previous;
+    }
+  }
+  free (parent);
+}
+
+unsigned nextRandom(unsigned* state)
+{
+  unsigned x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+void addUndirectedEdge(Graph* graph, int u, int v, int weight)
+{
+  Vertex *from = graph->vertices[u];
+  Vertex *to = graph->vertices[v];
+  from->adjList = graphNewEdgeList (graph, graphNewEdge (graph, u, v, weight),
+                                    from->adjList);
+  to->adjList = graphNewEdgeList (graph, graphNewEdge (graph, v, u, weight),
+                                  to->adjList);
+  graph->numEdges += 2;
+}
+
+Graph* gridGraph(int side, int maxWeight, unsigned seed)
+{
+  int numVertices = side * side;
+  Graph *graph = emptyGraph (numVertices, 4 * numVertices);
+
+  unsigned state = seed ? seed : 1;
+  for (int row = 0; row < side; row++)
+    for (int col = 0; col < side; col++)
+    {
+      int id = row * side + col;
+      if (col + 1 < side)
+        addUndirectedEdge (graph, id, id + 1, randomWeight (&state, maxWeight));
+      if (row + 1 < side)
+        addUndirectedEdge (graph, id, id + side,
+                           randomWeight (&state, maxWeight));
+    }
+  return graph;
+}
+
+Graph* rmatGraph(int scale, int edgeFactor, int maxWeight, unsigned seed)
+{
+  int numVertices = 1 << scale;
+  long long numEdges = (long long) edgeFactor * numVertices;
+  Graph *graph = emptyGraph (numVertices, 2 * numEdges);
+  unsigned state = seed ? seed : 1;
+
+  /* Shuffle the IDs; otherwise vertex 0 is always the hub. */
+  int *label = (int *) malloc (numVertices * sizeof (int));
+  for (int v = 0; v < numVertices; v++)
+    label[v] = v;
+  for (int v = numVertices - 1; v > 0; v--)
+  {
+    int u = nextRandom (&state) % (unsigned) (v + 1);
+    int swap = label[v];
+    label[v] = label[u];
+    label[u] = swap;
+  }
+
+  /* Every edge descends 'scale' levels of the adjacency matrix, picking a
+   * quadrant at each. */
+  for (long long e = 0; e < numEdges; e++)
+  {
+    int u = 0, v = 0;
+    for (int level = 0; level < scale; level++)
+    {
+      double r = randomFraction (&state);
+      int rowBit = r >= RMAT_A + RMAT_B;
+      int colBit = (r >= RMAT_A && r < RMAT_A + RMAT_B)
+                   || r >= RMAT_A + RMAT_B + RMAT_C;
+      u = (u << 1) | rowBit;
+      v = (v << 1) | colBit;
+    }
+    int weight = randomWeight (&state, maxWeight);
+    if (u != v)
+      addUndirectedEdge (graph, label[u], label[v], weight);
+  }
+  free (label);
+
+  connectComponents (graph, maxWeight);
+  return graph;
+}
+
+Graph* erdosRenyiGraph(int numVertices, int averageDegree, int maxWeight,
+                       unsigned seed)
+{
+  long long numEdges = (long long) numVertices * averageDegree / 2;
+  Graph *graph = emptyGraph (numVertices, 2 * numEdges);
+  unsigned state = seed ? seed : 1;
+
+  for (long long e = 0; numVertices > 1 && e < numEdges; e++)
+  {
+    int u = nextRandom (&state) % (unsigned) numVertices;
+    int v = nextRandom (&state) % (unsigned) (numVertices - 1);
+    if (v >= u)
+      v++;
+    addUndirectedEdge (graph, u, v, randomWeight (&state, maxWeight));
+  }
+
+  connectComponents (graph, maxWeight);
+  return graph;
+}
+
+Graph* geometricGraph(int numVertices, int averageDegree, int maxWeight,
+                      unsigned seed)
+{
+  int n = numVertices;
+  Graph *graph = emptyGraph (n, (long long) n * averageDegree);
+  unsigned state = seed ? seed : 1;
+  double radius = n > 0 ? sqrt (averageDegree / (M_PI * n)) : 1;
+
+  double *x = (double *) malloc (n * sizeof (double));
+  double *y = (double *) malloc (n * sizeof (double));
+  for (int v = 0; v < n; v++)
+  {
+    x[v] = randomFraction (&state);
+    y[v] = randomFraction (&state);
+  }
+
+  /* Bucket the points into square cells no smaller than the radius, so
+   * that the neighbours of a point are in its cell or the 8 around it. */
+  double cells = radius > 0 ? 1 / radius : n;
+  if (cells > sqrt ((double) n))
+    cells = sqrt ((double) n);
+  int cellsPerSide = cells < 1 ? 1 : (int) cells;
+  int numCells = cellsPerSide * cellsPerSide;
+  int *cellOf = (int *) malloc (n * sizeof (int));
+  int *cellStart = (int *) calloc (numCells + 1, sizeof (int));
+  int *byCell = (int *) malloc (n * sizeof (int));
+  for (int v = 0; v < n; v++)
+  {
+    int cx = (int) (x[v] * cellsPerSide);
+    int cy = (int) (y[v] * cellsPerSide);
+    cellOf[v] = cy * cellsPerSide + cx;
+    cellStart[cellOf[v] + 1]++;
+  }
+  for (int c = 0; c < numCells; c++)
+    cellStart[c + 1] += cellStart[c];
+  int *fill = (int *) malloc (numCells * sizeof (int));
+  for (int c = 0; c < numCells; c++)
+    fill[c] = cellStart[c];
+  for (int v = 0; v < n; v++)
+    byCell[fill[cellOf[v]]++] = v;
+  free (fill);
+
+  for (int u = 0; u < n; u++)
+  {
+    int cx = cellOf[u] % cellsPerSide;
+    int cy = cellOf[u] / cellsPerSide;
+    for (int ny = cy - 1; ny <= cy + 1; ny++)
+      for (int nx = cx - 1; nx <= cx + 1; nx++)
+      {
+        if (nx < 0 || ny < 0 || nx >= cellsPerSide || ny >= cellsPerSide)
+          continue;
+        int c = ny * cellsPerSide + nx;
+        for (int i = cellStart[c]; i < cellStart[c + 1]; i++)
+        {
+          int v = byCell[i];
+          if (v <= u)
+            continue;
+          double dx = x[u] - x[v];
+          double dy = y[u] - y[v];
+          double length = sqrt (dx * dx + dy * dy);
+          if (length <= radius)
+            addUndirectedEdge (graph, u, v,
+                               1 + (int) (length / radius * (maxWeight - 1)));
+        }
+      }
+  }
+
+  free (x);
+  free (y);
+  free (cellOf);
+  free (cellStart);
+  free (byCell);
+  connectComponents (graph, maxWeight);
+  return graph;
+}
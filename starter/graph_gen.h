@@ -0,0 +1,72 @@
+/*
+ * Header file for our synthetic graph generators.
+ *
+ * Every generator is deterministic for a given seed and returns an
+ * arena-backed, undirected graph: each edge is stored in both directions,
+ * so numEdges is twice the number of undirected edges. Weights are in
+ * [1, maxWeight]. The generated graphs are connected, as getMSTprim and
+ * getShortestPaths require: where the random model leaves several
+ * components, they are chained together by one edge of weight maxWeight
+ * per extra component.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "graph.h"
+
+#ifndef __Graph_Gen_header
+#define __Graph_Gen_header
+
+// R-MAT quadrant probabilities of the Graph 500 benchmark; d = 1 - a - b - c
+#define RMAT_A 0.57
+#define RMAT_B 0.19
+#define RMAT_C 0.19
+
+/*
+ * Advances the xorshift generator 'state', which must not be 0, and returns
+ * its next value.
+ */
+unsigned nextRandom(unsigned* state);
+
+/*
+ * Adds edges (u -- v, weight) and (v -- u, weight) to 'graph'.
+ */
+void addUndirectedEdge(Graph* graph, int u, int v, int weight);
+
+/*
+ * Returns a road-like graph: a 'side' x 'side' grid in which every vertex is
+ * joined to its horizontal and vertical neighbours by edges with random
+ * weights. Vertex row * side + col is in row 'row' and column 'col'.
+ */
+Graph* gridGraph(int side, int maxWeight, unsigned seed);
+
+/*
+ * Returns a power-law graph on 2^scale vertices with about
+ * edgeFactor * 2^scale undirected edges drawn by the recursive matrix
+ * (R-MAT) model, with random weights. Vertex IDs are shuffled so that
+ * degree does not follow the ID. Self-loops are dropped; parallel edges
+ * are kept.
+ * Precondition: 0 <= scale <= 30
+ */
+Graph* rmatGraph(int scale, int edgeFactor, int maxWeight, unsigned seed);
+
+/*
+ * Returns an Erdős–Rényi graph G(n, m) on 'numVertices' vertices with
+ * m = numVertices * averageDegree / 2 undirected edges between uniformly
+ * random distinct vertices, with random weights.
+ */
+Graph* erdosRenyiGraph(int numVertices, int averageDegree, int maxWeight,
+                       unsigned seed);
+
+/*
+ * Returns a random geometric graph: 'numVertices' uniformly random points
+ * in the unit square, joined iff they are within the radius that gives an
+ * expected degree of 'averageDegree'. The weight of an edge grows linearly
+ * with its length, from 1 to 'maxWeight' at the radius.
+ */
+Graph* geometricGraph(int numVertices, int averageDegree, int maxWeight,
+                      unsigned seed);
+
+#endif
@@ -0,0 +1,1026 @@
+/*
+ * Our readers for graph input files.
+ */
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "graph_loader.h"
+#include "graph_snapshot.h"
+#include "thread_team.h"
+
+// character classes of the scanner
+#define CHAR_OTHER 0
+#define CHAR_SPACE 1      // separates numbers within a line
+#define CHAR_NEWLINE 2    // ends a line
+#define CHAR_DIGIT 3
+
+static const unsigned char charClass[256] = {
+  [' '] = CHAR_SPACE, ['\t'] = CHAR_SPACE, ['\r'] = CHAR_SPACE,
+  ['\v'] = CHAR_SPACE, ['\f'] = CHAR_SPACE, ['\n'] = CHAR_NEWLINE,
+  ['0'] = CHAR_DIGIT, ['1'] = CHAR_DIGIT, ['2'] = CHAR_DIGIT,
+  ['3'] = CHAR_DIGIT, ['4'] = CHAR_DIGIT, ['5'] = CHAR_DIGIT,
+  ['6'] = CHAR_DIGIT, ['7'] = CHAR_DIGIT, ['8'] = CHAR_DIGIT,
+  ['9'] = CHAR_DIGIT,
+};
+
+typedef struct scanner {
+  const char* pos;    // next character to read
+  const char* end;    // one past the last character
+} Scanner;
+
+// kinds of errors in vertex lines
+#define LOAD_BAD_NUMBER 1      // a token is not an integer
+#define LOAD_BAD_VERTEX_ID 2   // a vertex ID is out of range
+#define LOAD_NO_WEIGHT 3       // the last edge of a line has no weight
+#define LOAD_BAD_WEIGHT 4      // an edge weight is negative or too large
+
+typedef struct load_error {
+  int kind;             // one of the LOAD_ kinds above
+  long long value;      // the offending number, if any
+  const char* token;    // the offending token, if any
+  size_t length;        // length of 'token'
+} LoadError;
+
+typedef struct edge_buffer {
+  int* targets;
+  int* weights;
+  size_t size;
+  size_t capacity;
+} EdgeBuffer;
+
+/*
+ * Returns the class of character 'c'.
+ */
+static inline int classOf(char c)
+{
+  return charClass[(unsigned char) c];
+}
+
+/*
+ * Returns a word whose byte i has its high bit set iff byte i of 'word' is
+ * above ' ', i.e. part of a token, and all other bits clear.
+ */
+static inline uint64_t tokenBytes(uint64_t word)
+{
+  const uint64_t low7 = 0x7f7f7f7f7f7f7f7fULL;
+  const uint64_t high = 0x8080808080808080ULL;
+  return (((word & low7) + 0x5f5f5f5f5f5f5f5fULL) | word) & high;
+}
+
+/*
+ * Returns the number of tokens in the 'length' bytes at 'text', counting
+ * every character up to ' ' as a separator. Looks at eight bytes at a time:
+ * a token starts at every token byte that follows a separator.
+ */
+static size_t countTokens(const char* text, size_t length)
+{
+  size_t count = 0;
+  size_t i = 0;
+  uint64_t previous = 0;   // high bit set iff the last byte was a token byte
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  for (; i + 8 <= length; i += 8)
+  {
+    uint64_t word;
+    memcpy (&word, text + i, 8);
+    uint64_t inToken = tokenBytes (word);
+    uint64_t starts = inToken & ~((inToken << 8) | previous);
+    count += __builtin_popcountll (starts);
+    previous = inToken >> 56;
+  }
+#endif
+  for (; i < length; i++)
+  {
+    uint64_t inToken = (unsigned char) text[i] > ' ' ? 0x80 : 0;
+    count += (inToken & ~previous) != 0;
+    previous = inToken;
+  }
+  return count;
+}
+
+/*
+ * Returns the number of leading decimal digits in the eight bytes of the
+ * little-endian 'word' (8 if all are digits).
+ */
+static inline int digitRun(uint64_t word)
+{
+  const uint64_t low7 = 0x7f7f7f7f7f7f7f7fULL;
+  const uint64_t high = 0x8080808080808080ULL;
+  uint64_t ascii = word & low7;
+  uint64_t atLeast0 = ascii + 0x5050505050505050ULL;   // byte >= '0'
+  uint64_t above9 = ascii + 0x4646464646464646ULL;     // byte > '9'
+  uint64_t digits = atLeast0 & ~above9 & ~word & high;
+  uint64_t others = ~digits & high;
+  return others ? __builtin_ctzll (others) >> 3 : 8;
+}
+
+/*
+ * Returns the value of the first 'length' bytes of the little-endian 'word',
+ * which are decimal digits, most significant first.
+ * Precondition: 1 <= length <= 8
+ */
+static inline uint64_t digitsValue(uint64_t word, int length)
+{
+  /* Keep the digits and move them to the top; the bytes below become
+   * leading zeros. Then combine pairs of digits, pairs of pairs, and so on. */
+  uint64_t v = (word & 0x0f0f0f0f0f0f0f0fULL) << (8 * (8 - length));
+  v = (v * ((10 << 8) + 1)) >> 8;
+  v = ((v & 0x00ff00ff00ff00ffULL) * ((100 << 16) + 1)) >> 16;
+  v = ((v & 0x0000ffff0000ffffULL) * ((10000ULL << 32) + 1)) >> 32;
+  return v;
+}
+
+/*
+ * Skips the spaces at the position of 's'. Returns true iff a token follows
+ * on the current line.
+ */
+static inline bool nextToken(Scanner* s)
+{
+  while (s->pos < s->end && classOf (*s->pos) == CHAR_SPACE)
+    s->pos++;
+  return s->pos < s->end && classOf (*s->pos) != CHAR_NEWLINE;
+}
+
+/*
+ * Moves 's' past the end of the current line.
+ */
+static void skipLine(Scanner* s)
+{
+  const char *newline = memchr (s->pos, '\n', s->end - s->pos);
+  s->pos = newline ? newline + 1 : s->end;
+}
+
+/*
+ * Records an error of kind 'kind' about 'value' or the token of 'length'
+ * bytes at 'token' in '*error', and returns false.
+ */
+static bool setError(LoadError* error, int kind, long long value,
+                     const char* token, size_t length)
+{
+  error->kind = kind;
+  error->value = value;
+  error->token = token;
+  error->length = length;
+  return false;
+}
+
+/*
+ * Prints the message the legacy reader prints for 'error'.
+ */
+static void printLoadError(LoadError* error)
+{
+  switch (error->kind)
+  {
+    case LOAD_BAD_NUMBER:
+      printf ("Invalid number: %.*s. Giving up.\n", (int) error->length,
+              error->token);
+      break;
+    case LOAD_BAD_VERTEX_ID:
+      printf ("Invalid vertex ID: %lld. Giving up.\n", error->value);
+      break;
+    case LOAD_NO_WEIGHT:
+      printf ("Could not read edge weight from input file. Giving up.\n");
+      break;
+    case LOAD_BAD_WEIGHT:
+      printf ("Invalid edge weight: %lld. Giving up.\n", error->value);
+      break;
+  }
+  printf ("Could not get vertex info from a line. Giving up.\n");
+}
+
+/*
+ * Parses the token at the position of 's' as a decimal integer with an
+ * optional sign into '*value', and moves 's' past it. Values outside the
+ * range of int are clamped to INT_MIN - 1 or INT_MAX + 1. Returns false and
+ * sets '*error' if the token is not an integer.
+ * Precondition: a token starts at the position of 's'
+ */
+static inline bool scanNumber(Scanner* s, long long* value, LoadError* error)
+{
+  const char *start = s->pos;
+  const char *p = s->pos;
+  bool negative = *p == '-';
+  if (*p == '-' || *p == '+')
+    p++;
+
+  const char *digits = p;
+  unsigned long long v = 0;
+  unsigned digit;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  /* Numbers of up to seven digits are read without a branch per digit. */
+  if (s->end - p >= 8)
+  {
+    uint64_t word;
+    memcpy (&word, p, 8);
+    int length = digitRun (word);
+    if (length > 0 && length < 8)
+    {
+      v = digitsValue (word, length);
+      p += length;
+    }
+  }
+#endif
+  while (p < s->end && (digit = (unsigned char) *p - '0') < 10)
+  {
+    v = v * 10 + digit;
+    p++;
+  }
+  /* More than 18 digits could have overflowed v. */
+  if (p - digits > 18 || v > INT_MAX)
+    v = (unsigned long long) INT_MAX + 1;
+
+  if (p == digits || (p < s->end && classOf (*p) == CHAR_OTHER))
+  {
+    while (p < s->end && classOf (*p) != CHAR_SPACE
+           && classOf (*p) != CHAR_NEWLINE)
+      p++;
+    return setError (error, LOAD_BAD_NUMBER, 0, start, p - start);
+  }
+  s->pos = p;
+  *value = negative ? -(long long) v : (long long) v;
+  return true;
+}
+
+/*
+ * Appends the edge to 'target' with weight 'weight' to 'edges'.
+ */
+static void pushEdge(EdgeBuffer* edges, int target, int weight)
+{
+  if (edges->size == edges->capacity)
+  {
+    edges->capacity = edges->capacity ? 2 * edges->capacity : 16;
+    edges->targets = (int *) realloc (edges->targets,
+                                      edges->capacity * sizeof (int));
+    edges->weights = (int *) realloc (edges->weights,
+                                      edges->capacity * sizeof (int));
+  }
+  edges->targets[edges->size] = target;
+  edges->weights[edges->size] = weight;
+  edges->size++;
+}
+
+/*
+ * Parses the vertex line at the position of 's' in a graph with
+ * 'numVertices' vertices: stores its vertex ID in '*id' and appends its
+ * edges to 'edges' in the order of the line. Moves 's' to the end of the
+ * line. Returns false and sets '*error' if the line is not valid; this is
+ * the validation of readVertexID and readWeight.
+ * Precondition: a token starts at the position of 's'
+ */
+static bool parseVertexLine(Scanner* s, int numVertices, int* id,
+                            EdgeBuffer* edges, LoadError* error)
+{
+  long long vertex, toVertex, weight;
+  if (!scanNumber (s, &vertex, error))
+    return false;
+  if (vertex < 0 || vertex >= numVertices)
+    return setError (error, LOAD_BAD_VERTEX_ID, vertex, NULL, 0);
+
+  while (nextToken (s))
+  {
+    if (!scanNumber (s, &toVertex, error))
+      return false;
+    if (toVertex < 0 || toVertex >= numVertices)
+      return setError (error, LOAD_BAD_VERTEX_ID, toVertex, NULL, 0);
+
+    if (!nextToken (s))
+      return setError (error, LOAD_NO_WEIGHT, 0, NULL, 0);
+    if (!scanNumber (s, &weight, error))
+      return false;
+    if (weight < 0 || weight > INT_MAX)
+      return setError (error, LOAD_BAD_WEIGHT, weight, NULL, 0);
+
+    pushEdge (edges, toVertex, weight);
+  }
+  *id = vertex;
+  return true;
+}
+
+/*
+ * Parses the first line of the text of 's', the number of vertices, and
+ * moves 's' to the second line. Returns the number of vertices, or -1 after
+ * printing why if it cannot be read.
+ */
+static int parseNumVertices(Scanner* s)
+{
+  long long numVertices;
+  LoadError error;
+
+  if (!nextToken (s))
+  {
+    printf ("Could not read number of vertices from input file. Giving up.\n");
+    return -1;
+  }
+  if (!scanNumber (s, &numVertices, &error))
+  {
+    printf ("Invalid number: %.*s. Giving up.\n", (int) error.length,
+            error.token);
+    return -1;
+  }
+  if (numVertices < 0 || numVertices > INT_MAX)
+  {
+    printf ("Number of vertices must be positive. Read: %lld. Giving up.\n",
+            numVertices);
+    return -1;
+  }
+  skipLine (s);
+  return numVertices;
+}
+
+/*
+ * Returns the Graph described by the 'length' bytes at 'text', allocated
+ * from an arena iff 'useArena', or NULL after printing why it is not valid.
+ */
+static Graph* parseText(const char* text, size_t length, bool useArena)
+{
+  Scanner s = { text, text + length };
+  int numVertices = parseNumVertices (&s);
+  if (numVertices < 0)
+    return NULL;
+
+  /* Every edge takes two tokens, so this bounds the number of edges. Only
+   * an arena uses the bound, to size its first slab. */
+  Graph *graph;
+  if (useArena)
+  {
+    size_t numTokens = countTokens (s.pos, s.end - s.pos);
+    int numEdgesHint = numTokens / 2 < INT_MAX ? numTokens / 2 : INT_MAX;
+    graph = newArenaGraph (numVertices, numEdgesHint);
+  }
+  else
+    graph = newGraph (numVertices);
+  if (graph == NULL)
+  {
+    printf ("Could not create a new graph. Giving up.\n");
+    return NULL;
+  }
+  memset (graph->vertices, 0, numVertices * sizeof (Vertex *));
+
+  EdgeBuffer edges = { NULL, NULL, 0, 0 };
+  LoadError error;
+  bool ok = true;
+  while (ok && s.pos < s.end)
+  {
+    if (nextToken (&s))
+    {
+      int id;
+      edges.size = 0;
+      ok = parseVertexLine (&s, numVertices, &id, &edges, &error);
+      if (!ok)
+      {
+        printLoadError (&error);
+        break;
+      }
+
+      EdgeList *head = NULL;
+      for (size_t i = 0; ok && i < edges.size; i++)
+      {
+        EdgeList *next = addEdge (graph, head, id, edges.targets[i],
+                                  edges.weights[i]);
+        ok = next != NULL;
+        if (ok)
+          head = next;
+      }
+      if (!ok)
+      {
+        printf ("Could not get vertex info from a line. Giving up.\n");
+        if (graph->arena == NULL)
+          deleteEdgeList (head);
+        break;
+      }
+      graph->numEdges += edges.size;
+      graph->vertices[id] = graphNewVertex (graph, id, NULL, head);
+    }
+    skipLine (&s);
+  }
+  free (edges.targets);
+  free (edges.weights);
+  if (!ok)
+  {
+    deleteGraph (graph);
+    return NULL;
+  }
+
+  for (int id = 0; id < numVertices; id++)
+    if (graph->vertices[id] == NULL)
+      graph->vertices[id] = graphNewVertex (graph, id, NULL, NULL);
+  return graph;
+}
+
+Graph* parseGraph(const char* text, size_t length)
+{
+  return parseText (text, length, false);
+}
+
+Graph* parseArenaGraph(const char* text, size_t length)
+{
+  return parseText (text, length, true);
+}
+
+/*
+ * Memory-maps the file 'filename', stores its length in '*length' and
+ * returns its text, or returns NULL after printing why it cannot. An empty
+ * file is returned as an empty string.
+ */
+static const char* mapFile(const char* filename, size_t* length)
+{
+  int fd = open (filename, O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat (fd, &st) != 0)
+  {
+    fprintf (stderr, "Unable to open the specified input file: %s\n", filename);
+    if (fd >= 0)
+      close (fd);
+    return NULL;
+  }
+
+  /* mmap cannot map an empty file. */
+  *length = st.st_size;
+  if (st.st_size == 0)
+  {
+    close (fd);
+    return "";
+  }
+
+  char *text = mmap (NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close (fd);
+  if (text == MAP_FAILED)
+  {
+    fprintf (stderr, "Unable to map the specified input file: %s\n", filename);
+    return NULL;
+  }
+  madvise (text, st.st_size, MADV_SEQUENTIAL);
+  return text;
+}
+
+/*
+ * Unmaps the text of 'length' bytes returned by mapFile.
+ */
+static void unmapFile(const char* text, size_t length)
+{
+  if (length > 0)
+    munmap ((void *) text, length);
+}
+
+/*
+ * Memory-maps the file 'filename' and returns the Graph it describes,
+ * allocated from an arena iff 'useArena', or NULL after printing why not.
+ */
+static Graph* loadText(const char* filename, bool useArena)
+{
+  size_t length;
+  const char *text = mapFile (filename, &length);
+  if (text == NULL)
+    return NULL;
+  Graph *graph = parseText (text, length, useArena);
+  unmapFile (text, length);
+  return graph;
+}
+
+Graph* loadGraph(const char* filename)
+{
+  return loadText (filename, false);
+}
+
+Graph* loadArenaGraph(const char* filename)
+{
+  return loadText (filename, true);
+}
+
+/***** Parallel loading *****************************************************/
+
+typedef struct line_record {
+  int id;               // the vertex the line describes
+  int numEdges;         // number of edges on the line
+  size_t firstEdge;     // position of its first edge in the chunk's buffer
+} LineRecord;
+
+typedef struct load_chunk {
+  const char* begin;    // the chunk is the whole lines in [begin, end)
+  const char* end;
+  LineRecord* lines;    // the vertex lines of the chunk, in order
+  int numLines;
+  int lineCapacity;
+  EdgeBuffer edges;     // the edges of all lines, in order
+  bool failed;          // true iff parsing stopped at an invalid line
+  LoadError error;      // why, if 'failed'
+} LoadChunk;
+
+typedef struct parallel_load {
+  int numVertices;
+  int numChunks;
+  LoadChunk* chunks;
+  atomic_llong* owner;  // owner[v] is chunk << 32 | line of the last line
+                        //   describing v, or -1 if there is none
+  int* offsets;         // numVertices+1 entries; edges of v in the result
+  CSRGraph* csr;        // the result
+} ParallelLoad;
+
+/*
+ * Splits the 'length' bytes at 'text' into 'numChunks' chunks of about
+ * equal size that end at line boundaries.
+ */
+static void splitChunks(LoadChunk* chunks, int numChunks, const char* text,
+                        size_t length)
+{
+  const char *end = text + length;
+  const char *begin = text;
+  for (int i = 0; i < numChunks; i++)
+  {
+    const char *split = i + 1 == numChunks ? end
+                        : text + length / numChunks * (i + 1);
+    if (split < begin)
+      split = begin;
+    if (split < end && split > text && split[-1] != '\n')
+    {
+      const char *newline = memchr (split, '\n', end - split);
+      split = newline ? newline + 1 : end;
+    }
+    chunks[i].begin = begin;
+    chunks[i].end = split;
+    begin = split;
+  }
+}
+
+/*
+ * Marks every vertex of the share of 'thread' as described by no line.
+ */
+static void clearOwnersTask(void* arg, int thread, int numThreads)
+{
+  ParallelLoad *pl = (ParallelLoad *) arg;
+  int begin, end;
+  teamSlice (pl->numVertices, thread, numThreads, &begin, &end);
+  for (int v = begin; v < end; v++)
+    atomic_init (&pl->owner[v], -1);
+}
+
+/*
+ * Parses chunk 'thread' into its own buffers, and records for every vertex
+ * the last line that describes it.
+ */
+static void parseChunkTask(void* arg, int thread, int numThreads)
+{
+  (void) numThreads;
+  ParallelLoad *pl = (ParallelLoad *) arg;
+  LoadChunk *chunk = &pl->chunks[thread];
+
+  /* Every edge takes two tokens, so this bounds the number of edges. */
+  size_t capacity = countTokens (chunk->begin, chunk->end - chunk->begin) / 2;
+  if (capacity > 0)
+  {
+    chunk->edges.capacity = capacity;
+    chunk->edges.targets = (int *) malloc (capacity * sizeof (int));
+    chunk->edges.weights = (int *) malloc (capacity * sizeof (int));
+  }
+
+  Scanner s = { chunk->begin, chunk->end };
+  while (s.pos < s.end)
+  {
+    if (nextToken (&s))
+    {
+      int id;
+      size_t firstEdge = chunk->edges.size;
+      if (!parseVertexLine (&s, pl->numVertices, &id, &chunk->edges,
+                            &chunk->error))
+      {
+        chunk->failed = true;
+        return;
+      }
+
+      if (chunk->numLines == chunk->lineCapacity)
+      {
+        chunk->lineCapacity = chunk->lineCapacity ? 2 * chunk->lineCapacity
+                                                  : 1024;
+        chunk->lines = (LineRecord *)
+          realloc (chunk->lines, chunk->lineCapacity * sizeof (LineRecord));
+      }
+      chunk->lines[chunk->numLines] = (LineRecord) {
+        id, chunk->edges.size - firstEdge, firstEdge };
+
+      /* A later line for the same vertex replaces an earlier one. */
+      long long key = (long long) thread << 32 | chunk->numLines;
+      long long old = atomic_load_explicit (&pl->owner[id],
+                                            memory_order_relaxed);
+      while (old < key
+             && !atomic_compare_exchange_weak (&pl->owner[id], &old, key))
+        ;
+      chunk->numLines++;
+    }
+    skipLine (&s);
+  }
+}
+
+/*
+ * Returns the line that describes vertex 'v' in 'pl', or NULL if none does.
+ */
+static LineRecord* ownerLine(ParallelLoad* pl, int v)
+{
+  long long key = atomic_load_explicit (&pl->owner[v], memory_order_relaxed);
+  if (key < 0)
+    return NULL;
+  return &pl->chunks[key >> 32].lines[key & 0xffffffff];
+}
+
+/*
+ * Stores the degree of every vertex of the share of 'thread' in offsets.
+ */
+static void degreeTask(void* arg, int thread, int numThreads)
+{
+  ParallelLoad *pl = (ParallelLoad *) arg;
+  int begin, end;
+  teamSlice (pl->numVertices, thread, numThreads, &begin, &end);
+  for (int v = begin; v < end; v++)
+  {
+    LineRecord *line = ownerLine (pl, v);
+    pl->offsets[v + 1] = line ? line->numEdges : 0;
+  }
+}
+
+/*
+ * Copies the edges of every vertex of the share of 'thread' into the CSR
+ * graph, in reverse order of their line like the adjacency lists of
+ * loadGraph.
+ */
+static void fillTask(void* arg, int thread, int numThreads)
+{
+  ParallelLoad *pl = (ParallelLoad *) arg;
+  int begin, end;
+  teamSlice (pl->numVertices, thread, numThreads, &begin, &end);
+  for (int v = begin; v < end; v++)
+  {
+    long long key = atomic_load_explicit (&pl->owner[v], memory_order_relaxed);
+    if (key < 0)
+      continue;
+    LoadChunk *chunk = &pl->chunks[key >> 32];
+    LineRecord *line = &chunk->lines[key & 0xffffffff];
+    int e = pl->csr->offsets[v];
+    for (size_t i = line->firstEdge + line->numEdges; i-- > line->firstEdge; )
+    {
+      pl->csr->targets[e] = chunk->edges.targets[i];
+      pl->csr->weights[e] = chunk->edges.weights[i];
+      e++;
+    }
+  }
+}
+
+/*
+ * Same as parseCSRParallel; also stores the number of edges on all lines,
+ * including lines replaced by a later line for the same vertex, in
+ * '*numParsedEdges', which is what graph->numEdges counts for loadGraph.
+ */
+static CSRGraph* parseParallel(const char* text, size_t length, int numThreads,
+                               long long* numParsedEdges)
+{
+  Scanner s = { text, text + length };
+  int numVertices = parseNumVertices (&s);
+  if (numVertices < 0)
+    return NULL;
+  if (numThreads < 1)
+    numThreads = 1;
+
+  ParallelLoad pl;
+  pl.numVertices = numVertices;
+  pl.numChunks = numThreads;
+  pl.chunks = (LoadChunk *) calloc (numThreads, sizeof (LoadChunk));
+  pl.owner = (atomic_llong *) malloc ((numVertices > 0 ? numVertices : 1)
+                                      * sizeof (atomic_llong));
+  pl.offsets = (int *) malloc ((numVertices + 1) * sizeof (int));
+  pl.csr = NULL;
+  splitChunks (pl.chunks, numThreads, s.pos, s.end - s.pos);
+
+  ThreadTeam *team = newThreadTeam (numThreads);
+  teamRun (team, clearOwnersTask, &pl);
+  teamRun (team, parseChunkTask, &pl);
+
+  /* The first failed chunk holds the first invalid line of the file. */
+  bool failed = false;
+  long long parsed = 0;
+  for (int i = 0; i < numThreads && !failed; i++)
+  {
+    failed = pl.chunks[i].failed;
+    if (failed)
+      printLoadError (&pl.chunks[i].error);
+    parsed += pl.chunks[i].edges.size;
+  }
+
+  if (!failed)
+  {
+    teamRun (team, degreeTask, &pl);
+    pl.offsets[0] = 0;
+    long long numEdges = 0;
+    for (int v = 0; v < numVertices; v++)
+    {
+      numEdges += pl.offsets[v + 1];
+      pl.offsets[v + 1] = numEdges <= INT_MAX ? numEdges : INT_MAX;
+    }
+    if (numEdges > INT_MAX)
+    {
+      printf ("Too many edges: %lld. Giving up.\n", numEdges);
+      failed = true;
+    }
+    else
+    {
+      pl.csr = newCSRGraph (numVertices, numEdges);
+      memcpy (pl.csr->offsets, pl.offsets, (numVertices + 1) * sizeof (int));
+      teamRun (team, fillTask, &pl);
+    }
+  }
+  deleteThreadTeam (team);
+
+  for (int i = 0; i < numThreads; i++)
+  {
+    free (pl.chunks[i].lines);
+    free (pl.chunks[i].edges.targets);
+    free (pl.chunks[i].edges.weights);
+  }
+  free (pl.chunks);
+  free (pl.owner);
+  free (pl.offsets);
+  if (numParsedEdges)
+    *numParsedEdges = parsed;
+  return failed ? NULL : pl.csr;
+}
+
+CSRGraph* parseCSRParallel(const char* text, size_t length, int numThreads)
+{
+  return parseParallel (text, length, numThreads, NULL);
+}
+
+CSRGraph* loadCSRParallel(const char* filename, int numThreads)
+{
+  size_t length;
+  const char *text = mapFile (filename, &length);
+  if (text == NULL)
+    return NULL;
+  CSRGraph *csr = parseParallel (text, length, numThreads, NULL);
+  unmapFile (text, length);
+  return csr;
+}
+
+Graph* loadGraphParallel(const char* filename, int numThreads)
+{
+  size_t length;
+  const char *text = mapFile (filename, &length);
+  if (text == NULL)
+    return NULL;
+  long long numParsedEdges;
+  CSRGraph *csr = parseParallel (text, length, numThreads, &numParsedEdges);
+  unmapFile (text, length);
+  if (csr == NULL)
+    return NULL;
+
+  Graph *graph = graphFromCSR (csr);
+  graph->numEdges = numParsedEdges;
+  deleteCSRGraph (csr);
+  return graph;
+}
+
+/***** Conversion to snapshots *********************************************/
+
+/*
+ * Writes the edge targets, or the edge weights if 'weights' is true, of
+ * every vertex of 'numVertices' to 'w', in the order of loadGraph's
+ * adjacency lists. The edges are scanned again from the line of every
+ * vertex in 'lines', ending at 'end', whose lines have already been
+ * validated.
+ */
+static void putLineValues(SnapshotWriter* w, const char** lines,
+                          const char* end, int numVertices, EdgeBuffer* edges,
+                          bool weights)
+{
+  LoadError error;
+  for (int v = 0; v < numVertices; v++)
+  {
+    if (lines[v] == NULL)
+      continue;
+    Scanner s = { lines[v], end };
+    int id;
+    edges->size = 0;
+    parseVertexLine (&s, numVertices, &id, edges, &error);
+    for (size_t i = edges->size; i-- > 0;)
+      snapshotPut (w, weights ? edges->weights[i] : edges->targets[i]);
+  }
+}
+
+bool convertGraphToSnapshot(const char* filename, const char* snapshotName)
+{
+  size_t length;
+  const char *text = mapFile (filename, &length);
+  if (text == NULL)
+    return false;
+  Scanner s = { text, text + length };
+  int numVertices = parseNumVertices (&s);
+  if (numVertices < 0)
+  {
+    unmapFile (text, length);
+    return false;
+  }
+
+  /* First pass: validate every line and find the last line of every
+   * vertex, as loadGraph keeps it. */
+  const char **lines = (const char **) calloc (numVertices, sizeof (char *));
+  int *degrees = (int *) calloc (numVertices, sizeof (int));
+  EdgeBuffer edges = { NULL, NULL, 0, 0 };
+  LoadError error;
+  bool ok = true;
+  while (ok && s.pos < s.end)
+  {
+    if (nextToken (&s))
+    {
+      const char *line = s.pos;
+      int id;
+      edges.size = 0;
+      ok = parseVertexLine (&s, numVertices, &id, &edges, &error);
+      if (!ok)
+      {
+        printLoadError (&error);
+        break;
+      }
+      lines[id] = line;
+      degrees[id] = edges.size;
+    }
+    skipLine (&s);
+  }
+
+  long long numEdges = 0;
+  for (int v = 0; ok && v < numVertices; v++)
+    numEdges += degrees[v];
+  if (ok && numEdges > INT_MAX)
+  {
+    printf ("Too many edges for a snapshot: %lld. Giving up.\n", numEdges);
+    ok = false;
+  }
+
+  /* Then one pass per array; the text pages are dropped from this process
+   * after every pass, so only the per-vertex arrays stay resident. */
+  SnapshotWriter *w = NULL;
+  if (ok)
+  {
+    w = newSnapshotWriter (snapshotName, numVertices, numEdges, false);
+    if (w == NULL)
+      fprintf (stderr, "Unable to create the snapshot file: %s\n",
+               snapshotName);
+  }
+  if (w != NULL)
+  {
+    madvise ((void *) text, length, MADV_DONTNEED);
+    int offset = 0;
+    snapshotPut (w, 0);
+    for (int v = 0; v < numVertices; v++)
+    {
+      offset += degrees[v];
+      snapshotPut (w, offset);
+    }
+    snapshotNextArray (w);
+    putLineValues (w, lines, s.end, numVertices, &edges, false);
+    madvise ((void *) text, length, MADV_DONTNEED);
+    snapshotNextArray (w);
+    putLineValues (w, lines, s.end, numVertices, &edges, true);
+    ok = finishSnapshot (w);
+    if (!ok)
+      fprintf (stderr, "Unable to write the snapshot file: %s\n",
+               snapshotName);
+  }
+
+  free (lines);
+  free (degrees);
+  free (edges.targets);
+  free (edges.weights);
+  unmapFile (text, length);
+  return ok && w != NULL;
+}
+
+/***** The original reader **************************************************/
+
+Graph* createGraph(FILE* f)
+{
+  char line[MAX_LIMIT];
+
+  if (!fgets (line, MAX_LIMIT, f)) // read first line
+  {
+    printf ("Could not read number of vertices from input file. Giving up.\n");
+    return NULL;
+  }
+
+  int numVertices = atoi (line);  // first line is number of vertices
+  if (numVertices < 0)
+  {
+    printf ("Number of vertices must be positive. Read: %d. Giving up.\n",
+            numVertices);
+    return NULL;
+  }
+
+  Graph *graph = newGraph (numVertices);
+  if (graph == NULL)
+  {
+    printf ("Could not create a new graph. Giving up.\n");
+    return NULL;
+  }
+
+  while (fgets (line, MAX_LIMIT, f)) // read next line
+  {
+    if (!updateVertex (graph, line)) // update vertex info from line
+    {
+      printf ("Could not get vertex info from a line. Giving up.\n");
+      deleteGraph (graph);
+      return NULL;
+    }
+  }
+  return graph;
+}
+
+bool updateVertex(Graph* graph, char* line)
+{
+  if (graph == NULL)
+    return false;
+
+  // parse vertex ID
+  char *token = strtok (line, " ");
+  int id = readVertexID (token, graph->numVertices);
+  if (id == -1)
+    return false;
+
+  // parse adjacency list
+  EdgeList *head = NULL;
+  int toVertex = 0;
+  int weight = 0;
+  token = strtok (NULL, " ");
+  while (token)
+  {
+    toVertex = readVertexID (token, graph->numVertices);
+    if (toVertex == -1)
+      return false;
+
+    token = strtok (NULL, " ");
+    weight = readWeight (token);
+    if (weight == -1)
+      return false;
+
+    head = addEdge (graph, head, id, toVertex, weight);
+    if (head == NULL)
+      return false;
+    graph->numEdges++;
+
+    token = strtok (NULL, " ");
+  }
+  graph->vertices[id] = graphNewVertex (graph, id, NULL, head);  // no values in our file
+
+  return true;
+}
+
+EdgeList* addEdge(Graph* graph, EdgeList* head, int fromVertex, int toVertex,
+                  int weight)
+{
+  Edge *edge = graphNewEdge (graph, fromVertex, toVertex, weight);
+  if (edge == NULL)
+  {
+    printf ("Could not allocate a new Edge. Giving up.\n");
+    return NULL;
+  }
+  EdgeList *edgeList = graphNewEdgeList (graph, edge, head);
+  if (edgeList == NULL)
+  {
+    printf ("Could not allocate a new EdgeList. Giving up.\n");
+    return NULL;
+  }
+  return edgeList;
+}
+
+int readVertexID(char* token, int numVertices)
+{
+  if (!token)
+  {
+    printf ("Could not read vertex ID from input file. Giving up.\n");
+    return -1;
+  }
+  int id = atoi (token);
+  if (id < 0 || id >= numVertices)
+  {
+    printf ("Invalid vertex ID: %d. Giving up.\n", id);
+    return -1;
+  }
+  return id;
+}
+
+int readWeight(char* token)
+{
+  if (!token)
+  {
+    printf ("Could not read edge weight from input file. Giving up.\n");
+    return -1;
+  }
+  int weight = atoi (token);
+  if (weight < 0)
+  {
+    printf ("Invalid edge weight: %d. Giving up.\n", weight);
+    return -1;
+  }
+  return weight;
+}
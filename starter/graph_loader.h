@@ -0,0 +1,139 @@
+/*
+ * Header file for reading our graphs from text files.
+ *
+ * The first line of an input file holds the number of vertices n. Every
+ * following line describes one vertex and its outgoing edges:
+ *   id to_1 weight_1 to_2 weight_2 ...
+ * where 0 <= id, to_i < n and weight_i >= 0. The adjacency list of vertex id
+ * holds its edges in reverse order of the line.
+ *
+ * loadGraph memory-maps the file and parses it with a hand-rolled scanner,
+ * and lines may be of any length. createGraph is the original reader,
+ * which uses fgets, strtok and atoi and silently truncates lines longer
+ * than MAX_LIMIT bytes. The Graphs of both can be edited with newEdge,
+ * newEdgeList, newVertex, deleteEdgeList and deleteVertex.
+ *
+ * loadArenaGraph parses the same way into an arena-backed Graph (see
+ * newArenaGraph): a counting pass over the text sizes the arena before any
+ * edge is created, and deleteGraph frees it in O(number of slabs). Its
+ * Graphs, and those of loadGraphParallel, must only be edited with
+ * graphNewEdge, graphNewEdgeList and graphNewVertex.
+ *
+ * The parallel loaders split the text at line boundaries into one chunk per
+ * thread. Every thread parses its chunk into its own edge buffers; a vertex
+ * described by several lines keeps the last one, found with an atomic
+ * maximum rather than a lock. The buffers are then merged into a CSRGraph
+ * with a parallel prefix of the degrees.
+ *
+ * convertGraphToSnapshot turns an input file into a snapshot (see
+ * graph_snapshot.h) for graphs that do not fit in memory. It keeps only
+ * per-vertex state in RAM and streams the edges from the mapped text to
+ * the snapshot, at the price of scanning every line three times.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "csr.h"
+#include "graph.h"
+
+#ifndef __Graph_Loader_header
+#define __Graph_Loader_header
+
+// longest line createGraph reads, including the newline
+#define MAX_LIMIT 1024
+
+/*
+ * Memory-maps the file 'filename' and returns the Graph it describes.
+ * Vertices without a line of their own get an empty adjacency list. Blank
+ * lines are skipped, and spaces, tabs and carriage returns all separate
+ * numbers. Returns NULL, after printing why, if the file cannot be read or
+ * is not a valid input file.
+ */
+Graph* loadGraph(const char* filename);
+
+/*
+ * Same as loadGraph, but parses the 'length' bytes at 'text', which need
+ * not be NUL-terminated.
+ */
+Graph* parseGraph(const char* text, size_t length);
+
+/*
+ * Same as loadGraph, but all Edges, EdgeLists and Vertices of the result
+ * are allocated from one arena.
+ */
+Graph* loadArenaGraph(const char* filename);
+
+/*
+ * Same as parseGraph, but all Edges, EdgeLists and Vertices of the result
+ * are allocated from one arena.
+ */
+Graph* parseArenaGraph(const char* text, size_t length);
+
+/*
+ * Same as loadGraph, but parses the file with 'numThreads' threads and
+ * returns it as a CSRGraph whose edges have the order of loadGraph's
+ * adjacency lists. Invalid input is reported with the messages of
+ * loadGraph, for the first invalid line in the file.
+ */
+CSRGraph* loadCSRParallel(const char* filename, int numThreads);
+
+/*
+ * Same as loadCSRParallel, but parses the 'length' bytes at 'text'.
+ */
+CSRGraph* parseCSRParallel(const char* text, size_t length, int numThreads);
+
+/*
+ * Same as loadGraph, but parses the file with 'numThreads' threads as
+ * loadCSRParallel does. The Edges, EdgeLists and Vertices of the result are
+ * allocated as three arrays from its arena.
+ */
+Graph* loadGraphParallel(const char* filename, int numThreads);
+
+/*
+ * Writes the graph described by the input file 'filename' to the snapshot
+ * file 'snapshotName', with the edges loadGraph would read, in the order of
+ * its adjacency lists. Neither the graph nor its edges are held in memory:
+ * only the position of the line of every vertex and its degree. Returns
+ * true iff successful, after printing why if not.
+ */
+bool convertGraphToSnapshot(const char* filename, const char* snapshotName);
+
+/*
+ * Creates and returns a new Graph from the information in the file 'f',
+ * reading it line by line with fgets. Returns NULL, after printing why, if
+ * 'f' is not a valid input file.
+ */
+Graph* createGraph(FILE* f);
+
+/*
+ * Updates / populates the corresponding vertex in 'graph' using information
+ * from the line 'line' in an input file. Returns true iff update was
+ * successful.
+ */
+bool updateVertex(Graph* graph, char* line);
+
+/*
+ * Prepends a new Edge from vertex 'fromVertex' to vertex 'toVertex' with
+ * weight 'weight', to the edge list 'head' and returns the result. The new
+ * Edge and EdgeList are allocated from the arena of 'graph', if any.
+ */
+EdgeList* addEdge(Graph* graph, EdgeList* head, int fromVertex, int toVertex,
+                  int weight);
+
+/*
+ * Parses and validates a vertex ID for a graph with 'numVertices' vertices,
+ * from 'token'. Returns the ID if validation is successful, and -1 if it is
+ * not.
+ */
+int readVertexID(char* token, int numVertices);
+
+/*
+ * Parses and validates an edge weight from 'token'. Returns the weight if
+ * validation is successful, and -1 if it not.
+ */
+int readWeight(char* token);
+
+#endif
@@ -0,0 +1,669 @@
+/*
+ *  A long-running query server for our graph algorithms.
+ *
+ *  mainprog loads the graph on every run; the server loads it once and
+ *  then answers a stream of requests, so the load time is paid once.
+ *
+ *  ---------------------------------------------------------------------------
+ *   Build:
+ *   make server
+ *
+ *   Run:
+ *   ./serverprog graph.txt [threads]
+ *      Reads requests from stdin and writes responses to stdout.
+ *
+ *   ./serverprog graph.txt [threads] socket_path
+ *      Listens on the Unix domain socket 'socket_path'; every connection
+ *      is a session of its own, and sessions run concurrently.
+ *
+ *   Protocol, one request per line, one response line per request:
+ *   mst s              ok us weight edges
+ *      Prim's algorithm from s: total weight and number of tree edges of
+ *      the spanning tree of the component of s.
+ *   sssp s [t ...]     ok us reached d_0 d_1 ... d_n-1
+ *      Dijkstra's algorithm from s: the number of vertices reached and
+ *      the distance to every vertex, or to t ... if given; -1 is
+ *      unreachable.
+ *   path s t           ok us distance hops s v_1 ... t
+ *      A shortest path from s to t, or "ok us -1" if there is none.
+ *   stats              ok us requests mean_us p50_us p99_us max_us
+ *      Latencies of all requests the server answered so far. They are
+ *      kept in a histogram of LATENCY_STEPS buckets per doubling, so the
+ *      percentiles are rounded up by at most 1/LATENCY_STEPS of themselves,
+ *      and the mean and maximum are exact.
+ *   quit               ends the session
+ *   shutdown           ends the session and stops the server
+ *
+ *   'us' is the latency of the request in microseconds, from reading it
+ *   to having its answer. A request that cannot be answered gets
+ *   "err us message"; so does a line of MAX_REQUEST bytes or more, as a
+ *   whole ("err us line too long"). Requests of a session are answered by
+ *   all worker threads in parallel, up to MAX_IN_FLIGHT at a time, but
+ *   responses come in the order of the requests.
+ *  ---------------------------------------------------------------------------
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "algo_stats.h"
+#include "graph.h"
+#include "graph_algos.h"
+#include "graph_loader.h"
+#include "workspace.h"
+
+#define MAX_IN_FLIGHT 1024  // unanswered requests a session may have
+#define MAX_REQUEST 4096    // request lines must be shorter than this
+#define LATENCY_STEPS 16    // latency buckets per doubling
+#define LATENCY_BUCKETS (40 * LATENCY_STEPS)  // bucket 0 holds latencies
+                                              //   up to 1 us, the last one
+                                              //   all above about 2^40 us
+
+typedef struct server Server;
+
+typedef struct session {
+  Server* server;
+  FILE* in;                 // requests
+  FILE* out;                // responses
+  pthread_mutex_t lock;     // protects all fields below
+  pthread_cond_t progress;  // signalled whenever a response is written
+  long long numRead;        // requests read so far
+  long long numWritten;     // responses written so far
+  char* pending[MAX_IN_FLIGHT];  // pending[seq % MAX_IN_FLIGHT] is the
+                                 //   response to request seq, if it is
+                                 //   done but not written yet
+} Session;
+
+typedef struct job {
+  Session* session;
+  long long seq;      // number of the request in its session
+  char* line;         // the request
+  double received;    // when the request was read, in seconds
+  struct job* next;
+} Job;
+
+struct server {
+  Graph* graph;
+  int numWorkers;
+  pthread_t* workers;
+  pthread_mutex_t lock;        // protects all fields below
+  pthread_cond_t wakeUp;       // signalled when a job is queued or on stop
+  pthread_cond_t sessionsDone; // signalled when the last session ends
+  Job* head;                   // the queue of jobs, oldest first
+  Job* tail;
+  bool stopping;               // true once the workers should exit
+  bool shutdown;               // true once a client asked to shut down
+  int numSessions;             // sessions still running
+  int listenFd;                // the listening socket, or -1 for stdin
+  long long numLatencies;      // requests answered
+  double totalLatency;         // sum of their latencies, in seconds
+  double maxLatency;           // largest of their latencies, in seconds
+  long long latencyCounts[LATENCY_BUCKETS];  // requests per latency bucket
+};
+
+typedef struct worker_state {
+  Server* server;
+  Workspace* ws;    // the state of this worker's searches
+  Edge* tree;       // numVertices Edges for distance trees
+} WorkerState;
+
+int latencyBucket(double seconds);
+double bucketLimit(int bucket);
+bool parseVertex(const char* token, int numVertices, int* id);
+
+Server* newServer(Graph* graph, int numWorkers);
+void stopServer(Server* server);
+void* workerMain(void* arg);
+char* formatResponse(Server* server, bool ok, double received,
+                     const char* body);
+bool answer(WorkerState* w, char* line, FILE* body);
+void answerStats(Server* server, FILE* body);
+void recordLatency(Server* server, double seconds);
+
+void runSession(Server* server, FILE* in, FILE* out);
+void deliver(Session* session, long long seq, char* response);
+void* sessionMain(void* arg);
+int serveSocket(Server* server, const char* path);
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    printf("Usage: %s graph.txt [threads] [socket_path]\n", argv[0]);
+    return 1;
+  }
+
+  double start = statsNow();
+  Graph* graph = loadArenaGraph(argv[1]);
+  if (graph == NULL)
+    return 1;
+  int numWorkers = argc > 2 ? atoi(argv[2]) : 4;
+  fprintf(stderr, "loaded %d vertices and %d edges in %.1f ms\n",
+          graph->numVertices, graph->numEdges,
+          (statsNow() - start) * 1000);
+
+  // a client that disconnects early must not kill the server
+  signal(SIGPIPE, SIG_IGN);
+
+  Server* server = newServer(graph, numWorkers);
+  int status = 0;
+  if (argc > 3)
+    status = serveSocket(server, argv[3]);
+  else
+    runSession(server, stdin, stdout);
+  stopServer(server);
+  deleteGraph(graph);
+  return status;
+}
+
+/*
+ * Returns the histogram bucket of the latency 'seconds': bucket b > 0
+ * holds latencies in (bucketLimit(b - 1), bucketLimit(b)] microseconds.
+ */
+int latencyBucket(double seconds)
+{
+  double us = seconds * 1e6;
+  if (!(us > 1))
+    return 0;
+  double bucket = ceil(log2(us) * LATENCY_STEPS);
+  return bucket < LATENCY_BUCKETS - 1 ? (int) bucket : LATENCY_BUCKETS - 1;
+}
+
+/*
+ * Returns the largest latency in microseconds that bucket 'bucket' holds.
+ */
+double bucketLimit(int bucket)
+{
+  return exp2((double) bucket / LATENCY_STEPS);
+}
+
+/*
+ * Parses the vertex ID 'token' of a graph with 'numVertices' vertices into
+ * '*id'. Returns true iff 'token' is a whole number of a valid vertex.
+ */
+bool parseVertex(const char* token, int numVertices, int* id)
+{
+  if (token == NULL)
+    return false;
+  char* end;
+  errno = 0;
+  long value = strtol(token, &end, 10);
+  if (errno != 0 || end == token || *end != '\0' || value < 0
+      || value >= numVertices)
+    return false;
+  *id = (int) value;
+  return true;
+}
+
+/*
+ * Returns a newly created server for 'graph' with 'numWorkers' worker
+ * threads running.
+ */
+Server* newServer(Graph* graph, int numWorkers)
+{
+  Server* server = (Server*) malloc(sizeof(Server));
+  server->graph = graph;
+  server->numWorkers = numWorkers < 1 ? 1 : numWorkers;
+  server->workers = (pthread_t*) malloc(server->numWorkers
+                                        * sizeof(pthread_t));
+  pthread_mutex_init(&server->lock, NULL);
+  pthread_cond_init(&server->wakeUp, NULL);
+  pthread_cond_init(&server->sessionsDone, NULL);
+  server->head = NULL;
+  server->tail = NULL;
+  server->stopping = false;
+  server->shutdown = false;
+  server->numSessions = 0;
+  server->listenFd = -1;
+  server->numLatencies = 0;
+  server->totalLatency = 0;
+  server->maxLatency = 0;
+  memset(server->latencyCounts, 0, sizeof(server->latencyCounts));
+
+  for (int t = 0; t < server->numWorkers; t++)
+    pthread_create(&server->workers[t], NULL, workerMain, server);
+  return server;
+}
+
+/*
+ * Stops the workers of 'server', once the queue is empty, prints a summary
+ * of its latencies to stderr, and frees all memory allocated for it.
+ */
+void stopServer(Server* server)
+{
+  pthread_mutex_lock(&server->lock);
+  server->stopping = true;
+  pthread_cond_broadcast(&server->wakeUp);
+  pthread_mutex_unlock(&server->lock);
+  for (int t = 0; t < server->numWorkers; t++)
+    pthread_join(server->workers[t], NULL);
+
+  char* summary = NULL;
+  size_t size = 0;
+  FILE* body = open_memstream(&summary, &size);
+  answerStats(server, body);
+  fclose(body);
+  fprintf(stderr, "requests mean_us p50_us p99_us max_us: %s\n", summary);
+  free(summary);
+
+  pthread_mutex_destroy(&server->lock);
+  pthread_cond_destroy(&server->wakeUp);
+  pthread_cond_destroy(&server->sessionsDone);
+  free(server->workers);
+  free(server);
+}
+
+/*
+ * Body of every worker thread: answers queued requests until the server
+ * stops and the queue is empty.
+ */
+void* workerMain(void* arg)
+{
+  Server* server = (Server*) arg;
+  WorkerState w;
+  w.server = server;
+  w.ws = newWorkspace(server->graph->numVertices);
+  w.tree = (Edge*) malloc(server->graph->numVertices * sizeof(Edge));
+
+  while (true)
+  {
+    pthread_mutex_lock(&server->lock);
+    while (server->head == NULL && !server->stopping)
+      pthread_cond_wait(&server->wakeUp, &server->lock);
+    Job* job = server->head;
+    if (job != NULL)
+    {
+      server->head = job->next;
+      if (server->head == NULL)
+        server->tail = NULL;
+    }
+    pthread_mutex_unlock(&server->lock);
+    if (job == NULL)
+      break;
+
+    char* body = NULL;
+    size_t size = 0;
+    FILE* stream = open_memstream(&body, &size);
+    bool ok = answer(&w, job->line, stream);
+    fclose(stream);
+
+    char* response = formatResponse(server, ok, job->received, body);
+    free(body);
+    deliver(job->session, job->seq, response);
+    free(job->line);
+    free(job);
+  }
+
+  deleteWorkspace(w.ws);
+  free(w.tree);
+  return NULL;
+}
+
+/*
+ * Records the latency of a request read at time 'received' in 'server', and
+ * returns its newly allocated response line: "ok" or "err" (per 'ok'), the
+ * latency in microseconds and 'body'.
+ */
+char* formatResponse(Server* server, bool ok, double received,
+                     const char* body)
+{
+  double latency = statsNow() - received;
+  recordLatency(server, latency);
+  size_t length = strlen(body) + 48;
+  char* response = (char*) malloc(length);
+  snprintf(response, length, "%s %lld %s\n", ok ? "ok" : "err",
+           (long long) (latency * 1e6), body);
+  return response;
+}
+
+/*
+ * Answers the request 'line' with the state of worker 'w': writes the
+ * response after its latency to 'body' and returns true, or writes an
+ * error message and returns false.
+ */
+bool answer(WorkerState* w, char* line, FILE* body)
+{
+  Graph* graph = w->server->graph;
+  int n = graph->numVertices;
+  char* save;
+  char* command = strtok_r(line, " \t\r\n", &save);
+  int source, target;
+
+  if (strcmp(command, "stats") == 0)
+  {
+    answerStats(w->server, body);
+    return true;
+  }
+
+  if (strcmp(command, "mst") != 0 && strcmp(command, "sssp") != 0
+      && strcmp(command, "path") != 0)
+  {
+    fprintf(body, "unknown request %s", command);
+    return false;
+  }
+  if (!parseVertex(strtok_r(NULL, " \t\r\n", &save), n, &source))
+  {
+    fprintf(body, "invalid or missing vertex");
+    return false;
+  }
+
+  if (strcmp(command, "mst") == 0)
+  {
+    Edge* mst = getMSTprimWS(w->ws, graph, source);
+    int numTreeEdges = w->ws->numTouched - 1;
+    long long weight = 0;
+    for (int i = 0; i < numTreeEdges; i++)
+      weight += mst[i].weight;
+    free(mst);
+    fprintf(body, "%lld %d", weight, numTreeEdges);
+    return true;
+  }
+
+  if (strcmp(command, "sssp") == 0)
+  {
+    // a request line holds fewer than MAX_REQUEST / 2 targets
+    int targets[MAX_REQUEST / 2];
+    int numTargets = 0;
+    for (char* token = strtok_r(NULL, " \t\r\n", &save); token != NULL;
+         token = strtok_r(NULL, " \t\r\n", &save))
+      if (!parseVertex(token, n, &targets[numTargets++]))
+      {
+        fprintf(body, "invalid target %s", token);
+        return false;
+      }
+
+    fillDistanceTreeWS(w->ws, graph, source, w->tree);
+    fprintf(body, "%d", w->ws->numTouched);
+    for (int i = 0; i < (numTargets ? numTargets : n); i++)
+    {
+      dist_t distance = w->tree[numTargets ? targets[i] : i].weight;
+      if (distance == DIST_MAX)
+        fprintf(body, " -1");
+      else
+        fprintf(body, " %" PRIdist, distance);
+    }
+    return true;
+  }
+
+  if (strcmp(command, "path") == 0)
+  {
+    if (!parseVertex(strtok_r(NULL, " \t\r\n", &save), n, &target))
+    {
+      fprintf(body, "invalid or missing target");
+      return false;
+    }
+    EdgeList* path = NULL;
+    dist_t distance = getShortestPathDijkstra(w->ws, graph, source, target,
+                                              &path);
+    if (distance == NOTHING)
+    {
+      fprintf(body, "-1");
+      return true;
+    }
+
+    int hops = 0;
+    for (EdgeList* l = path; l != NULL; l = l->next)
+      hops++;
+    fprintf(body, "%" PRIdist " %d %d", distance, hops, source);
+    for (EdgeList* l = path; l != NULL; l = l->next)
+      fprintf(body, " %d", l->edge->toVertex);
+    deleteEdgeList(path);
+    return true;
+  }
+  return false;
+}
+
+/*
+ * Writes the number of answered requests and the mean, median, 99th
+ * percentile and maximum of their latencies in microseconds to 'body'.
+ * The percentiles are the upper limits of their histogram buckets, but at
+ * most the maximum.
+ */
+void answerStats(Server* server, FILE* body)
+{
+  pthread_mutex_lock(&server->lock);
+  long long count = server->numLatencies;
+  double mean = count ? server->totalLatency / count * 1e6 : 0;
+  double max = server->maxLatency * 1e6;
+  double percentiles[2] = {0, 0};
+  long long ranks[2] = {(count - 1) / 2, (count - 1) * 99 / 100};
+  long long seen = 0;
+  for (int b = 0, p = 0; b < LATENCY_BUCKETS && p < 2 && count > 0; b++)
+  {
+    seen += server->latencyCounts[b];
+    for (; p < 2 && seen > ranks[p]; p++)
+      percentiles[p] = fmin(bucketLimit(b), max);
+  }
+  pthread_mutex_unlock(&server->lock);
+
+  fprintf(body, "%lld %.0f %.0f %.0f %.0f", count, mean, percentiles[0],
+          percentiles[1], max);
+}
+
+/*
+ * Adds the latency 'seconds' of an answered request to 'server'.
+ */
+void recordLatency(Server* server, double seconds)
+{
+  int bucket = latencyBucket(seconds);
+  pthread_mutex_lock(&server->lock);
+  server->numLatencies++;
+  server->totalLatency += seconds;
+  if (seconds > server->maxLatency)
+    server->maxLatency = seconds;
+  server->latencyCounts[bucket]++;
+  pthread_mutex_unlock(&server->lock);
+}
+
+/*
+ * Reads requests from 'in' and queues them for the workers of 'server'
+ * until 'in' ends or a quit or shutdown request, then waits until all
+ * their responses are written to 'out'.
+ */
+void runSession(Server* server, FILE* in, FILE* out)
+{
+  Session session;
+  session.server = server;
+  session.in = in;
+  session.out = out;
+  pthread_mutex_init(&session.lock, NULL);
+  pthread_cond_init(&session.progress, NULL);
+  session.numRead = 0;
+  session.numWritten = 0;
+  for (int i = 0; i < MAX_IN_FLIGHT; i++)
+    session.pending[i] = NULL;
+
+  // getline reads whole lines, so the tail of a long one is never taken
+  // for a request of its own
+  char* line = NULL;
+  size_t lineCapacity = 0;
+  ssize_t length;
+  while ((length = getline(&line, &lineCapacity, in)) != -1)
+  {
+    double received = statsNow();
+    bool tooLong = length >= MAX_REQUEST;
+    char command[16] = "";
+    if (!tooLong && sscanf(line, "%15s", command) != 1)
+      continue;
+    if (strcmp(command, "quit") == 0)
+      break;
+    if (strcmp(command, "shutdown") == 0)
+    {
+      pthread_mutex_lock(&server->lock);
+      server->shutdown = true;
+      if (server->listenFd >= 0)
+        shutdown(server->listenFd, SHUT_RDWR);
+      pthread_mutex_unlock(&server->lock);
+      break;
+    }
+
+    // wait for room, so that a fast client cannot queue without bound
+    pthread_mutex_lock(&session.lock);
+    while (session.numRead - session.numWritten >= MAX_IN_FLIGHT)
+      pthread_cond_wait(&session.progress, &session.lock);
+    long long seq = session.numRead++;
+    pthread_mutex_unlock(&session.lock);
+
+    if (tooLong)
+    {
+      deliver(&session, seq, formatResponse(server, false, received,
+                                            "line too long"));
+      continue;
+    }
+
+    Job* job = (Job*) malloc(sizeof(Job));
+    job->session = &session;
+    job->seq = seq;
+    job->line = strdup(line);
+    job->received = received;
+    job->next = NULL;
+
+    pthread_mutex_lock(&server->lock);
+    if (server->tail)
+      server->tail->next = job;
+    else
+      server->head = job;
+    server->tail = job;
+    pthread_cond_signal(&server->wakeUp);
+    pthread_mutex_unlock(&server->lock);
+  }
+  free(line);
+
+  pthread_mutex_lock(&session.lock);
+  while (session.numWritten < session.numRead)
+    pthread_cond_wait(&session.progress, &session.lock);
+  pthread_mutex_unlock(&session.lock);
+
+  pthread_mutex_destroy(&session.lock);
+  pthread_cond_destroy(&session.progress);
+}
+
+/*
+ * Hands the response 'response' to request 'seq' of 'session' over, and
+ * writes all responses that are now next in order.
+ */
+void deliver(Session* session, long long seq, char* response)
+{
+  pthread_mutex_lock(&session->lock);
+  session->pending[seq % MAX_IN_FLIGHT] = response;
+  char** next = &session->pending[session->numWritten % MAX_IN_FLIGHT];
+  while (*next != NULL)
+  {
+    fputs(*next, session->out);
+    free(*next);
+    *next = NULL;
+    session->numWritten++;
+    next = &session->pending[session->numWritten % MAX_IN_FLIGHT];
+  }
+  fflush(session->out);
+  pthread_cond_broadcast(&session->progress);
+  pthread_mutex_unlock(&session->lock);
+}
+
+typedef struct connection {
+  Server* server;
+  int fd;
+} Connection;
+
+/*
+ * Body of the thread of every socket connection: runs its session, then
+ * closes it.
+ */
+void* sessionMain(void* arg)
+{
+  Connection* c = (Connection*) arg;
+  Server* server = c->server;
+  FILE* in = fdopen(c->fd, "r");
+  FILE* out = fdopen(dup(c->fd), "w");
+  if (in != NULL && out != NULL)
+    runSession(server, in, out);
+  if (in != NULL)
+    fclose(in);
+  if (out != NULL)
+    fclose(out);
+  free(c);
+
+  pthread_mutex_lock(&server->lock);
+  if (--server->numSessions == 0)
+    pthread_cond_signal(&server->sessionsDone);
+  pthread_mutex_unlock(&server->lock);
+  return NULL;
+}
+
+/*
+ * Listens on the Unix domain socket 'path' and runs a session for every
+ * connection, until a client asks to shut down; then waits for all
+ * sessions to end. Returns 0, or 1 if the socket cannot be opened.
+ */
+int serveSocket(Server* server, const char* path)
+{
+  struct sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (strlen(path) >= sizeof(address.sun_path))
+  {
+    fprintf(stderr, "socket path too long: %s\n", path);
+    return 1;
+  }
+  strcpy(address.sun_path, path);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  unlink(path);
+  if (fd < 0 || bind(fd, (struct sockaddr*) &address, sizeof(address)) != 0
+      || listen(fd, 16) != 0)
+  {
+    fprintf(stderr, "cannot listen on %s: %s\n", path, strerror(errno));
+    if (fd >= 0)
+      close(fd);
+    return 1;
+  }
+  server->listenFd = fd;
+  fprintf(stderr, "listening on %s\n", path);
+
+  while (true)
+  {
+    int client = accept(fd, NULL, NULL);
+    pthread_mutex_lock(&server->lock);
+    bool stop = server->shutdown;
+    if (client >= 0 && !stop)
+      server->numSessions++;
+    pthread_mutex_unlock(&server->lock);
+    if (stop)
+    {
+      if (client >= 0)
+        close(client);
+      break;
+    }
+    if (client < 0)
+    {
+      if (errno == EINTR || errno == ECONNABORTED)
+        continue;
+      fprintf(stderr, "accept failed: %s\n", strerror(errno));
+      break;
+    }
+
+    Connection* c = (Connection*) malloc(sizeof(Connection));
+    c->server = server;
+    c->fd = client;
+    pthread_t thread;
+    pthread_create(&thread, NULL, sessionMain, c);
+    pthread_detach(thread);
+  }
+
+  pthread_mutex_lock(&server->lock);
+  while (server->numSessions > 0)
+    pthread_cond_wait(&server->sessionsDone, &server->lock);
+  server->listenFd = -1;
+  pthread_mutex_unlock(&server->lock);
+  close(fd);
+  unlink(path);
+  return 0;
+}
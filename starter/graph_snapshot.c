@@ -0,0 +1,427 @@
+/*
+ * Our binary graph snapshots.
+ */
+
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "graph_snapshot.h"
+#include "reorder.h"
+
+// words buffered by the writer between writes
+#define WRITE_BUFFER_WORDS 4096
+
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+// arrays of a snapshot, in file order
+#define ARRAY_OFFSETS 0
+#define ARRAY_TARGETS 1
+#define ARRAY_WEIGHTS 2
+#define ARRAY_IDS 3
+
+// bytes of the header of a version 1 snapshot
+#define HEADER_SIZE_V1 offsetof (SnapshotHeader, idsPos)
+
+struct snapshot_writer {
+  FILE* file;
+  SnapshotHeader header;  // written over the provisional one at the end
+  int array;              // the array being written, an ARRAY_ constant
+  int lastArray;          // ARRAY_WEIGHTS, or ARRAY_IDS with original IDs
+  uint64_t numPut;        // values put into the current array so far
+  uint64_t pos;           // bytes written so far
+  uint64_t checksum;      // of all words written so far
+  int32_t buffer[WRITE_BUFFER_WORDS];
+  int numBuffered;
+  bool ok;                // false once a write failed or a size was wrong
+};
+
+/*
+ * Returns 'checksum' updated with the 'count' words at 'words'.
+ */
+static uint64_t hashWords(uint64_t checksum, const int32_t* words,
+                          size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+    checksum = (checksum ^ (uint32_t) words[i]) * FNV_PRIME;
+  return checksum;
+}
+
+/*
+ * Writes the buffered words of 'w' to its file.
+ */
+static void flushWords(SnapshotWriter* w)
+{
+  if (w->numBuffered == 0)
+    return;
+  w->checksum = hashWords (w->checksum, w->buffer, w->numBuffered);
+  if (fwrite (w->buffer, sizeof (int32_t), w->numBuffered, w->file)
+      != (size_t) w->numBuffered)
+    w->ok = false;
+  w->pos += w->numBuffered * sizeof (int32_t);
+  w->numBuffered = 0;
+}
+
+/*
+ * Pads the snapshot written by 'w' with zero bytes up to the next multiple
+ * of SNAPSHOT_ALIGN, and returns the new position.
+ */
+static uint64_t alignWriter(SnapshotWriter* w)
+{
+  flushWords (w);
+  static const char zeros[SNAPSHOT_ALIGN];
+  size_t padding = (SNAPSHOT_ALIGN - w->pos % SNAPSHOT_ALIGN) % SNAPSHOT_ALIGN;
+  if (padding > 0 && fwrite (zeros, 1, padding, w->file) != padding)
+    w->ok = false;
+  w->pos += padding;
+  return w->pos;
+}
+
+/*
+ * Returns the number of values of the array 'array' of the snapshot written
+ * by 'w'.
+ */
+static uint64_t arraySize(SnapshotWriter* w, int array)
+{
+  if (array == ARRAY_OFFSETS)
+    return w->header.numVertices + 1;
+  if (array == ARRAY_IDS)
+    return w->header.numVertices;
+  return w->header.numEdges;
+}
+
+/*
+ * Returns the header field holding the position of the array 'array' of the
+ * snapshot written by 'w'.
+ */
+static uint64_t* arrayPos(SnapshotWriter* w, int array)
+{
+  switch (array)
+  {
+    case ARRAY_OFFSETS:
+      return &w->header.offsetsPos;
+    case ARRAY_TARGETS:
+      return &w->header.targetsPos;
+    case ARRAY_WEIGHTS:
+      return &w->header.weightsPos;
+    default:
+      return &w->header.idsPos;
+  }
+}
+
+SnapshotWriter* newSnapshotWriter(const char* filename, int numVertices,
+                                  int numEdges, bool withIds)
+{
+  FILE *file = fopen (filename, "wb");
+  if (file == NULL)
+    return NULL;
+
+  SnapshotWriter *w = (SnapshotWriter *) malloc (sizeof (SnapshotWriter));
+  w->file = file;
+  memset (&w->header, 0, sizeof (w->header));
+  memcpy (w->header.magic, SNAPSHOT_MAGIC, 4);
+  w->header.version = SNAPSHOT_VERSION;
+  w->header.byteOrder = SNAPSHOT_BYTE_ORDER;
+  w->header.headerSize = sizeof (SnapshotHeader);
+  w->header.numVertices = numVertices;
+  w->header.numEdges = numEdges;
+  w->array = ARRAY_OFFSETS;
+  w->lastArray = withIds ? ARRAY_IDS : ARRAY_WEIGHTS;
+  w->numPut = 0;
+  w->checksum = FNV_OFFSET_BASIS;
+  w->numBuffered = 0;
+
+  /* The provisional header has fileSize 0, so an unfinished snapshot is
+   * rejected by openSnapshot. */
+  w->ok = fwrite (&w->header, sizeof (w->header), 1, file) == 1;
+  w->pos = sizeof (w->header);
+  w->header.offsetsPos = alignWriter (w);
+  return w;
+}
+
+void snapshotPut(SnapshotWriter* w, int value)
+{
+  w->buffer[w->numBuffered++] = value;
+  w->numPut++;
+  if (w->numBuffered == WRITE_BUFFER_WORDS)
+    flushWords (w);
+}
+
+void snapshotNextArray(SnapshotWriter* w)
+{
+  if (w->array == w->lastArray || w->numPut != arraySize (w, w->array))
+  {
+    w->ok = false;
+    return;
+  }
+  w->array++;
+  w->numPut = 0;
+  *arrayPos (w, w->array) = alignWriter (w);
+}
+
+bool finishSnapshot(SnapshotWriter* w)
+{
+  if (w->array != w->lastArray || w->numPut != arraySize (w, w->array))
+    w->ok = false;
+  w->header.fileSize = alignWriter (w);
+  w->header.checksum = w->checksum;
+  if (w->ok)
+    w->ok = fseek (w->file, 0, SEEK_SET) == 0
+            && fwrite (&w->header, sizeof (w->header), 1, w->file) == 1;
+  bool ok = fclose (w->file) == 0 && w->ok;
+  free (w);
+  return ok;
+}
+
+bool writeSnapshot(CSRGraph* csr, const char* filename)
+{
+  SnapshotWriter *w = newSnapshotWriter (filename, csr->numVertices,
+                                         csr->numEdges, false);
+  if (w == NULL)
+    return false;
+
+  for (int v = 0; v <= csr->numVertices; v++)
+    snapshotPut (w, csr->offsets[v]);
+  snapshotNextArray (w);
+  for (int e = 0; e < csr->numEdges; e++)
+    snapshotPut (w, csr->targets[e]);
+  snapshotNextArray (w);
+  for (int e = 0; e < csr->numEdges; e++)
+    snapshotPut (w, csr->weights[e]);
+  return finishSnapshot (w);
+}
+
+bool writeSnapshotFromGraph(Graph* graph, const char* filename)
+{
+  /* Count the real number of edges rather than trusting graph->numEdges. */
+  long long numEdges = 0;
+  for (int v = 0; v < graph->numVertices; v++)
+    for (EdgeList *l = graph->vertices[v]->adjList; l != NULL; l = l->next)
+      numEdges++;
+  if (numEdges > INT_MAX)
+    return false;
+
+  SnapshotWriter *w = newSnapshotWriter (filename, graph->numVertices,
+                                         numEdges, false);
+  if (w == NULL)
+    return false;
+
+  /* One pass over the adjacency lists per array. */
+  int offset = 0;
+  snapshotPut (w, 0);
+  for (int v = 0; v < graph->numVertices; v++)
+  {
+    for (EdgeList *l = graph->vertices[v]->adjList; l != NULL; l = l->next)
+      offset++;
+    snapshotPut (w, offset);
+  }
+  snapshotNextArray (w);
+  for (int v = 0; v < graph->numVertices; v++)
+    for (EdgeList *l = graph->vertices[v]->adjList; l != NULL; l = l->next)
+      snapshotPut (w, l->edge->toVertex);
+  snapshotNextArray (w);
+  for (int v = 0; v < graph->numVertices; v++)
+    for (EdgeList *l = graph->vertices[v]->adjList; l != NULL; l = l->next)
+      snapshotPut (w, l->edge->weight);
+  return finishSnapshot (w);
+}
+
+/*
+ * Returns true iff the 'count' words of 4 bytes at file position 'pos'
+ * lie within a file of 'fileSize' bytes and 'pos' is aligned.
+ */
+static bool validSection(uint64_t pos, uint64_t count, uint64_t fileSize)
+{
+  return pos % SNAPSHOT_ALIGN == 0 && pos <= fileSize
+         && count <= (fileSize - pos) / sizeof (int32_t);
+}
+
+/*
+ * Returns NULL if 'header' describes a valid snapshot of 'fileSize' bytes,
+ * or else the reason why not.
+ */
+static const char* checkHeader(SnapshotHeader* header, uint64_t fileSize)
+{
+  if (memcmp (header->magic, SNAPSHOT_MAGIC, 4) != 0)
+    return "not a graph snapshot";
+  if (header->byteOrder != SNAPSHOT_BYTE_ORDER)
+    return "written with a different byte order";
+  if (!(header->version == 1 && header->headerSize == HEADER_SIZE_V1)
+      && !(header->version == SNAPSHOT_VERSION
+           && header->headerSize == sizeof (SnapshotHeader)))
+    return "unsupported snapshot version";
+  if (header->fileSize != fileSize || fileSize < header->headerSize)
+    return "truncated snapshot";
+
+  /* Version 1 headers end before idsPos. */
+  uint64_t idsPos = header->version == 1 ? 0 : header->idsPos;
+  if (header->numVertices < 0 || header->numVertices >= INT_MAX
+      || header->numEdges < 0 || header->numEdges > INT_MAX
+      || !validSection (header->offsetsPos, header->numVertices + 1, fileSize)
+      || !validSection (header->targetsPos, header->numEdges, fileSize)
+      || !validSection (header->weightsPos, header->numEdges, fileSize)
+      || (idsPos != 0
+          && !validSection (idsPos, header->numVertices, fileSize)))
+    return "corrupt snapshot header";
+  return NULL;
+}
+
+GraphSnapshot* openSnapshot(const char* filename, bool verify)
+{
+  int fd = open (filename, O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat (fd, &st) != 0)
+  {
+    fprintf (stderr, "Unable to open the snapshot file: %s\n", filename);
+    if (fd >= 0)
+      close (fd);
+    return NULL;
+  }
+  if ((size_t) st.st_size < HEADER_SIZE_V1)
+  {
+    fprintf (stderr, "Invalid snapshot %s: not a graph snapshot\n", filename);
+    close (fd);
+    return NULL;
+  }
+
+  /* MAP_SHARED lets all processes that map the file share its pages. */
+  void *mapping = mmap (NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+  if (mapping == MAP_FAILED)
+  {
+    fprintf (stderr, "Unable to map the snapshot file: %s\n", filename);
+    return NULL;
+  }
+
+  SnapshotHeader *header = (SnapshotHeader *) mapping;
+  const char *problem = checkHeader (header, st.st_size);
+  if (problem)
+  {
+    fprintf (stderr, "Invalid snapshot %s: %s\n", filename, problem);
+    munmap (mapping, st.st_size);
+    return NULL;
+  }
+
+  GraphSnapshot *snapshot = (GraphSnapshot *) malloc (sizeof (GraphSnapshot));
+  snapshot->header = header;
+  snapshot->mapping = mapping;
+  snapshot->mappingSize = st.st_size;
+  snapshot->csr.numVertices = header->numVertices;
+  snapshot->csr.numEdges = header->numEdges;
+  snapshot->csr.offsets = (int *) ((char *) mapping + header->offsetsPos);
+  snapshot->csr.targets = (int *) ((char *) mapping + header->targetsPos);
+  snapshot->csr.weights = (int *) ((char *) mapping + header->weightsPos);
+  snapshot->originalIds = NULL;
+  if (header->version > 1 && header->idsPos != 0)
+    snapshot->originalIds = (int *) ((char *) mapping + header->idsPos);
+
+  if (verify && !verifySnapshot (snapshot))
+  {
+    fprintf (stderr, "Invalid snapshot %s: checksum or structure mismatch\n",
+             filename);
+    closeSnapshot (snapshot);
+    return NULL;
+  }
+  return snapshot;
+}
+
+bool verifySnapshot(GraphSnapshot* snapshot)
+{
+  CSRGraph *csr = &snapshot->csr;
+  int n = csr->numVertices;
+  int m = csr->numEdges;
+  adviseSnapshot (snapshot, SNAPSHOT_ACCESS_SEQUENTIAL);
+
+  uint64_t checksum = FNV_OFFSET_BASIS;
+  checksum = hashWords (checksum, csr->offsets, n + 1);
+  checksum = hashWords (checksum, csr->targets, m);
+  checksum = hashWords (checksum, csr->weights, m);
+  if (snapshot->originalIds != NULL)
+    checksum = hashWords (checksum, snapshot->originalIds, n);
+  bool ok = checksum == snapshot->header->checksum;
+
+  ok = ok && csr->offsets[0] == 0 && csr->offsets[n] == m;
+  for (int v = 0; ok && v < n; v++)
+    ok = csr->offsets[v] <= csr->offsets[v + 1];
+  for (int e = 0; ok && e < m; e++)
+    ok = csr->targets[e] >= 0 && csr->targets[e] < n && csr->weights[e] >= 0;
+  for (int v = 0; ok && snapshot->originalIds != NULL && v < n; v++)
+    ok = snapshot->originalIds[v] >= 0 && snapshot->originalIds[v] < n;
+
+  adviseSnapshot (snapshot, SNAPSHOT_ACCESS_NORMAL);
+  return ok;
+}
+
+void adviseSnapshot(GraphSnapshot* snapshot, SnapshotAccess access)
+{
+  int advice = MADV_NORMAL;
+  if (access == SNAPSHOT_ACCESS_SEQUENTIAL)
+    advice = MADV_SEQUENTIAL;
+  else if (access == SNAPSHOT_ACCESS_RANDOM)
+    advice = MADV_RANDOM;
+  else if (access == SNAPSHOT_ACCESS_DONE)
+    advice = MADV_DONTNEED;
+  madvise (snapshot->mapping, snapshot->mappingSize, advice);
+}
+
+bool reorderSnapshot(GraphSnapshot* snapshot, const char* filename)
+{
+  CSRGraph *csr = &snapshot->csr;
+  int n = csr->numVertices;
+  Permutation *perm = getVertexOrder (csr, ORDER_BFS);
+  int *order = perm->oldId;
+  int *newId = perm->newId;
+
+  SnapshotWriter *w = newSnapshotWriter (filename, n, csr->numEdges, true);
+  if (w != NULL)
+  {
+    int offset = 0;
+    snapshotPut (w, 0);
+    for (int i = 0; i < n; i++)
+    {
+      offset += csr->offsets[order[i] + 1] - csr->offsets[order[i]];
+      snapshotPut (w, offset);
+    }
+    snapshotNextArray (w);
+    for (int i = 0; i < n; i++)
+      for (int e = csr->offsets[order[i]]; e < csr->offsets[order[i] + 1]; e++)
+        snapshotPut (w, newId[csr->targets[e]]);
+    snapshotNextArray (w);
+    for (int i = 0; i < n; i++)
+      for (int e = csr->offsets[order[i]]; e < csr->offsets[order[i] + 1]; e++)
+        snapshotPut (w, csr->weights[e]);
+    snapshotNextArray (w);
+
+    /* Reordering a reordered snapshot keeps the first original IDs. */
+    for (int i = 0; i < n; i++)
+      snapshotPut (w, snapshot->originalIds ? snapshot->originalIds[order[i]]
+                                            : order[i]);
+  }
+
+  deletePermutation (perm);
+  return w != NULL && finishSnapshot (w);
+}
+
+int findSnapshotVertex(GraphSnapshot* snapshot, int originalId)
+{
+  if (!(0 <= originalId && originalId < snapshot->csr.numVertices))
+    return -1;
+  if (snapshot->originalIds == NULL)
+    return originalId;
+  for (int v = 0; v < snapshot->csr.numVertices; v++)
+    if (snapshot->originalIds[v] == originalId)
+      return v;
+  return -1;
+}
+
+void closeSnapshot(GraphSnapshot* snapshot)
+{
+  if (snapshot == NULL)
+    return;
+  munmap (snapshot->mapping, snapshot->mappingSize);
+  free (snapshot);
+}
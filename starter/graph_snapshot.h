@@ -0,0 +1,165 @@
+/*
+ * Header file for our binary graph snapshots.
+ *
+ * A snapshot stores a graph in CSR form so that it can be used straight
+ * from a read-only memory mapping: a fixed header, then the offsets,
+ * targets and weights arrays and optionally an array of original vertex
+ * IDs, each starting at a multiple of SNAPSHOT_ALIGN bytes. Integers are
+ * stored in native byte order; the header records it so that a foreign
+ * snapshot is rejected instead of misread. The header also holds a
+ * checksum of the arrays.
+ *
+ * Opening a snapshot only maps it and checks its header, so start-up time
+ * does not depend on the size of the graph, and processes that open the
+ * same snapshot share its pages in the page cache. The CSRGraph of an open
+ * snapshot points into the mapping and can be passed directly to the CSR
+ * algorithms, e.g. getMSTprimCSR and getDistanceTreeDijkstraCSR.
+ *
+ * This also makes snapshots the out-of-core representation of graphs too
+ * large for memory: the CSR algorithms keep only per-vertex state in RAM,
+ * while the adjacency arrays are paged in from the file on demand and
+ * evicted by the kernel under memory pressure. Snapshots can be written
+ * by streaming, without the graph in memory (see convertGraphToSnapshot in
+ * graph_loader.h), and reorderSnapshot renumbers the vertices in
+ * breadth-first order so that a search touches few distinct pages.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "csr.h"
+#include "graph.h"
+
+#ifndef __Graph_Snapshot_header
+#define __Graph_Snapshot_header
+
+#define SNAPSHOT_MAGIC "GASN"
+#define SNAPSHOT_VERSION 2               // version 1 has no original IDs
+#define SNAPSHOT_ALIGN 64                // alignment of every array
+#define SNAPSHOT_BYTE_ORDER 0x01020304u  // reads differently if swapped
+
+typedef struct snapshot_header {
+  char magic[4];          // SNAPSHOT_MAGIC, without the NUL
+  uint32_t version;       // SNAPSHOT_VERSION
+  uint32_t byteOrder;     // SNAPSHOT_BYTE_ORDER as written by the writer
+  uint32_t headerSize;    // sizeof (SnapshotHeader)
+  int64_t numVertices;
+  int64_t numEdges;
+  uint64_t offsetsPos;    // file positions of the arrays, in bytes
+  uint64_t targetsPos;
+  uint64_t weightsPos;
+  uint64_t fileSize;      // total size of the snapshot, in bytes
+  uint64_t checksum;      // FNV-1a over the 32-bit words of offsets,
+                          //   targets, weights and original IDs, in order
+  uint64_t idsPos;        // position of the original IDs, or 0 if none;
+                          //   not in version 1
+} SnapshotHeader;
+
+typedef struct graph_snapshot {
+  CSRGraph csr;           // the graph; its arrays point into the mapping
+                          //   and must not be freed or written
+  const int* originalIds; // originalIds[v] is the ID vertex v had in the
+                          //   graph the snapshot was made from, or NULL
+                          //   if the IDs were kept
+  SnapshotHeader* header; // the header, at the start of the mapping
+  void* mapping;          // the read-only mapping of the whole file
+  size_t mappingSize;     // its size in bytes
+} GraphSnapshot;
+
+// expected access patterns of the arrays of a snapshot, for adviseSnapshot
+typedef enum snapshot_access {
+  SNAPSHOT_ACCESS_NORMAL,     // default read-ahead
+  SNAPSHOT_ACCESS_SEQUENTIAL, // in order: aggressive read-ahead
+  SNAPSHOT_ACCESS_RANDOM,     // scattered: no read-ahead
+  SNAPSHOT_ACCESS_DONE        // not for now: drop the pages of this process
+} SnapshotAccess;
+
+typedef struct snapshot_writer SnapshotWriter;
+
+/*
+ * Writes 'csr' as a snapshot to the file 'filename'. Returns true iff
+ * successful.
+ */
+bool writeSnapshot(CSRGraph* csr, const char* filename);
+
+/*
+ * Writes 'graph' as a snapshot to the file 'filename', streaming its
+ * adjacency lists without building a CSRGraph first. The edges of every
+ * vertex keep the order of its adjacency list. Returns true iff successful.
+ */
+bool writeSnapshotFromGraph(Graph* graph, const char* filename);
+
+/*
+ * Starts writing a snapshot of a graph with 'numVertices' vertices and
+ * 'numEdges' edges to the file 'filename', and returns a writer for it, or
+ * NULL if the file cannot be created. The arrays are then written one value
+ * at a time with snapshotPut, in file order: offsets, targets, weights and,
+ * iff 'withIds' is true, original IDs. Each array is ended with
+ * snapshotNextArray, except the last, which is ended with finishSnapshot.
+ */
+SnapshotWriter* newSnapshotWriter(const char* filename, int numVertices,
+                                  int numEdges, bool withIds);
+
+/*
+ * Appends 'value' to the array being written by 'writer'.
+ */
+void snapshotPut(SnapshotWriter* writer, int value);
+
+/*
+ * Ends the array being written by 'writer' and starts the next one.
+ */
+void snapshotNextArray(SnapshotWriter* writer);
+
+/*
+ * Ends the last array and the snapshot written by 'writer', and frees
+ * 'writer'. Returns true iff every write succeeded and all arrays had the
+ * right sizes; otherwise the file is left as an invalid snapshot.
+ */
+bool finishSnapshot(SnapshotWriter* writer);
+
+/*
+ * Maps the snapshot in the file 'filename' read-only and returns it, or
+ * returns NULL after printing why if it is not a valid snapshot. Only the
+ * header is checked, unless 'verify' is true; then the checksum and the
+ * structure of the arrays (monotone offsets, targets in range) are checked
+ * as well, which reads the whole file.
+ */
+GraphSnapshot* openSnapshot(const char* filename, bool verify);
+
+/*
+ * Returns true iff the arrays of 'snapshot' match its checksum and form a
+ * valid CSR graph.
+ */
+bool verifySnapshot(GraphSnapshot* snapshot);
+
+/*
+ * Tells the kernel how the arrays of 'snapshot' will be read next, so that
+ * it can adjust read-ahead or release the pages mapped by this process.
+ */
+void adviseSnapshot(GraphSnapshot* snapshot, SnapshotAccess access);
+
+/*
+ * Writes 'snapshot' to the file 'filename' with its vertices renumbered in
+ * breadth-first order, so that vertices close in the graph are close in
+ * the file; every search restarts from the lowest unvisited vertex. The
+ * new snapshot records the original ID of every vertex. Only per-vertex
+ * state is held in memory. Returns true iff successful.
+ */
+bool reorderSnapshot(GraphSnapshot* snapshot, const char* filename);
+
+/*
+ * Returns the vertex of 'snapshot' whose original ID is 'originalId', or
+ * -1 if there is none. Takes time linear in the number of vertices when
+ * the snapshot was reordered.
+ */
+int findSnapshotVertex(GraphSnapshot* snapshot, int originalId);
+
+/*
+ * Unmaps 'snapshot' and frees all memory allocated for it.
+ */
+void closeSnapshot(GraphSnapshot* snapshot);
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Our zero-copy shortest path views.
+ */
+
+#include "graph_algos.h"
+#include "path_view.h"
+
+PathIterator pathIterator(Edge* distTree, int startVertex, int vertex)
+{
+  PathIterator it = { distTree, startVertex, vertex };
+  return it;
+}
+
+bool pathNext(PathIterator* it, Edge* edge)
+{
+  int v = it->current;
+  if (v == NOTHING || v == it->startVertex)
+    return false;
+
+  int next = it->distTree[v].toVertex;
+  if (next == NOTHING)
+  {
+    it->current = NOTHING;
+    return false;
+  }
+
+  edge->fromVertex = v;
+  edge->toVertex = next;
+  edge->weight = it->distTree[v].weight - it->distTree[next].weight;
+  it->current = next;
+  return true;
+}
+
+int pathHops(Edge* distTree, int startVertex, int vertex)
+{
+  PathIterator it = pathIterator (distTree, startVertex, vertex);
+  Edge edge;
+  int hops = 0;
+  while (pathNext (&it, &edge))
+    hops++;
+  return hops;
+}
+
+EdgeList* pathToEdgeList(Edge* distTree, int startVertex, int vertex)
+{
+  PathIterator it = pathIterator (distTree, startVertex, vertex);
+  Edge edge;
+  EdgeList *head = NULL;
+  EdgeList **tail = &head;
+  while (pathNext (&it, &edge))
+  {
+    *tail = newEdgeList (newEdge (edge.fromVertex, edge.toVertex, edge.weight),
+                         NULL);
+    tail = &(*tail)->next;
+  }
+  return head;
+}
+
+void printPathView(Edge* distTree, int startVertex, int vertex)
+{
+  PathIterator it = pathIterator (distTree, startVertex, vertex);
+  Edge edge;
+  while (pathNext (&it, &edge))
+  {
+    printEdge (&edge);
+    printf (" --> ");
+  }
+  printf ("NULL");
+}
@@ -0,0 +1,64 @@
+/*
+ * Header file for our zero-copy shortest path views.
+ *
+ * A distance tree already is a shared-suffix tree of all shortest paths to
+ * its start vertex: distTree[id] is the first edge of the path from id, and
+ * the rest of that path is the path from the edge's other endpoint. A
+ * PathIterator walks this tree one edge at a time, so reading a path takes
+ * no memory beyond the iterator itself, unlike getShortestPaths, which
+ * copies every path into its own EdgeList.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "graph.h"
+
+#ifndef __PathView_header
+#define __PathView_header
+
+typedef struct path_iterator {
+  Edge* distTree;     // the distance tree that is walked
+  int startVertex;    // the start vertex of 'distTree'; paths end here
+  int current;        // the vertex the next edge leaves from, or NOTHING
+                      //   once the path is exhausted
+} PathIterator;
+
+/*
+ * Returns an iterator over the path from 'vertex' to 'startVertex' in the
+ * distance tree 'distTree' produced by Dijkstra's algorithm from
+ * 'startVertex'.
+ * Precondition: 'vertex' and 'startVertex' are valid in 'distTree'
+ */
+PathIterator pathIterator(Edge* distTree, int startVertex, int vertex);
+
+/*
+ * Stores the next edge of the path of 'it' in '*edge' and returns true, or
+ * returns false if the path has no more edges. The edges come in the order
+ * and form getShortestPaths produces:
+ *   (id -- id_1, w_0), (id_1 -- id_2, w_1), ..., (id_n -- start, w_n)
+ * A vertex the tree marks unreachable (predecessor NOTHING) has no edges.
+ */
+bool pathNext(PathIterator* it, Edge* edge);
+
+/*
+ * Returns the number of edges on the path from 'vertex' to 'startVertex' in
+ * 'distTree'.
+ */
+int pathHops(Edge* distTree, int startVertex, int vertex);
+
+/*
+ * Returns the path from 'vertex' to 'startVertex' in 'distTree' as a newly
+ * created list of edges, the same list getShortestPaths stores for
+ * 'vertex'. Only needed where an EdgeList is required.
+ */
+EdgeList* pathToEdgeList(Edge* distTree, int startVertex, int vertex);
+
+/*
+ * Prints the path from 'vertex' to 'startVertex' in 'distTree' in the
+ * format of printEdgeList, without materializing it.
+ */
+void printPathView(Edge* distTree, int startVertex, int vertex);
+
+#endif
@@ -0,0 +1,194 @@
+/*
+ * Our concurrent multi-source query engine.
+ *
+ * The unclaimed sources of every thread form a range [front, back) of
+ * indices into the batch, packed into one 64-bit word (front in the high
+ * half) so that it can be shrunk from either end with a single
+ * compare-and-swap. The owner takes sources from the front; thieves take
+ * them from the back, so they only meet on the last source of a range.
+ * Every slot fills a cache line of its own, so claiming sources does not
+ * slow down the other threads.
+ */
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "graph_algos.h"
+#include "query_pool.h"
+#include "thread_team.h"
+
+#define POOL_LINE_SIZE 64
+
+typedef struct pool_slot {
+  _Alignas (POOL_LINE_SIZE) _Atomic uint64_t range;  // packed [front, back)
+  Workspace* ws;    // the per-vertex state of this thread's queries
+  int steals;       // queries of other ranges run by this thread
+  int numTrees;     // trees written by this thread
+} PoolSlot;
+
+struct query_pool {
+  ThreadTeam* team;
+  PoolSlot* slots;    // slots[t] belongs to thread t
+  Graph* graph;       // the graph of the running batch
+  int* sources;       // the sources of the running batch
+  Edge** trees;       // the output trees of the running batch
+  int numSteals;      // steals in the last batch
+};
+
+static uint64_t packRange(int front, int back)
+{
+  return (uint64_t) front << 32 | (uint32_t) back;
+}
+
+static int frontOf(uint64_t range)
+{
+  return (int) (range >> 32);
+}
+
+static int backOf(uint64_t range)
+{
+  return (int) (uint32_t) range;
+}
+
+/*
+ * Claims the first unclaimed source of 'slot' and returns its index in the
+ * batch, or NOTHING if the range of 'slot' is empty.
+ */
+static int claimFront(PoolSlot* slot)
+{
+  uint64_t old = atomic_load_explicit (&slot->range, memory_order_relaxed);
+  while (frontOf (old) < backOf (old))
+    if (atomic_compare_exchange_weak (&slot->range, &old,
+                                      packRange (frontOf (old) + 1,
+                                                 backOf (old))))
+      return frontOf (old);
+  return NOTHING;
+}
+
+/*
+ * Same as claimFront, but claims the last unclaimed source of 'slot'.
+ */
+static int claimBack(PoolSlot* slot)
+{
+  uint64_t old = atomic_load_explicit (&slot->range, memory_order_relaxed);
+  while (frontOf (old) < backOf (old))
+    if (atomic_compare_exchange_weak (&slot->range, &old,
+                                      packRange (frontOf (old),
+                                                 backOf (old) - 1)))
+      return backOf (old) - 1;
+  return NOTHING;
+}
+
+/*
+ * Runs the query with index 'i' of the running batch on thread 'thread'.
+ */
+static void runQuery(QueryPool* pool, int thread, int i)
+{
+  PoolSlot *slot = &pool->slots[thread];
+  if (fillDistanceTreeWS (slot->ws, pool->graph, pool->sources[i],
+                          pool->trees[i]))
+    slot->numTrees++;
+}
+
+/*
+ * Team task: runs the queries of this thread's range, then steals from the
+ * other threads, starting with the next one, until all ranges are empty.
+ */
+static void queryTask(void* arg, int thread, int numThreads)
+{
+  QueryPool *pool = (QueryPool *) arg;
+  PoolSlot *slot = &pool->slots[thread];
+
+  /* Workspaces are kept across batches of graphs of the same size. */
+  if (slot->ws == NULL || slot->ws->numVertices != pool->graph->numVertices)
+  {
+    if (slot->ws != NULL)
+      deleteWorkspace (slot->ws);
+    slot->ws = newWorkspace (pool->graph->numVertices);
+  }
+
+  for (int i = claimFront (slot); i != NOTHING; i = claimFront (slot))
+    runQuery (pool, thread, i);
+
+  for (int k = 1; k < numThreads; k++)
+  {
+    PoolSlot *victim = &pool->slots[(thread + k) % numThreads];
+    for (int i = claimBack (victim); i != NOTHING; i = claimBack (victim))
+    {
+      runQuery (pool, thread, i);
+      slot->steals++;
+    }
+  }
+}
+
+QueryPool* newQueryPool(int numThreads)
+{
+  QueryPool *pool = (QueryPool *) malloc (sizeof (QueryPool));
+  pool->team = newThreadTeam (numThreads);
+  int n = pool->team->numThreads;
+  pool->slots = (PoolSlot *) aligned_alloc (POOL_LINE_SIZE,
+                                            n * sizeof (PoolSlot));
+  for (int t = 0; t < n; t++)
+  {
+    atomic_init (&pool->slots[t].range, packRange (0, 0));
+    pool->slots[t].ws = NULL;
+    pool->slots[t].steals = 0;
+    pool->slots[t].numTrees = 0;
+  }
+  pool->graph = NULL;
+  pool->sources = NULL;
+  pool->trees = NULL;
+  pool->numSteals = 0;
+  return pool;
+}
+
+int getDistanceTreesBatch(QueryPool* pool, Graph* graph, int* sources,
+                          int numSources, Edge** trees)
+{
+  int numThreads = pool->team->numThreads;
+  pool->graph = graph;
+  pool->sources = sources;
+  pool->trees = trees;
+  for (int t = 0; t < numThreads; t++)
+  {
+    int begin, end;
+    teamSlice (numSources, t, numThreads, &begin, &end);
+    atomic_store (&pool->slots[t].range, packRange (begin, end));
+    pool->slots[t].steals = 0;
+    pool->slots[t].numTrees = 0;
+  }
+
+  teamRun (pool->team, queryTask, pool);
+
+  int numTrees = 0;
+  pool->numSteals = 0;
+  for (int t = 0; t < numThreads; t++)
+  {
+    numTrees += pool->slots[t].numTrees;
+    pool->numSteals += pool->slots[t].steals;
+  }
+  return numTrees;
+}
+
+int queryPoolThreads(QueryPool* pool)
+{
+  return pool->team->numThreads;
+}
+
+int queryPoolSteals(QueryPool* pool)
+{
+  return pool->numSteals;
+}
+
+void deleteQueryPool(QueryPool* pool)
+{
+  if (pool == NULL)
+    return;
+  int numThreads = pool->team->numThreads;
+  deleteThreadTeam (pool->team);
+  for (int t = 0; t < numThreads; t++)
+    if (pool->slots[t].ws != NULL)
+      deleteWorkspace (pool->slots[t].ws);
+  free (pool->slots);
+  free (pool);
+}
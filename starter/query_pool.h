@@ -0,0 +1,68 @@
+/*
+ * Header file for our concurrent multi-source query engine.
+ *
+ * A QueryPool runs batches of single-source shortest path queries over the
+ * same read-only Graph on a fixed set of threads. Every thread keeps its
+ * own Workspace between batches, so a query allocates nothing. The sources
+ * of a batch are split into one contiguous range per thread; a thread that
+ * runs out of sources steals the last unclaimed ones of another thread's
+ * range, so uneven query costs do not leave threads idle.
+ *
+ *   QueryPool *pool = newQueryPool (4);
+ *   Edge **trees = ...;   // numSources arrays of graph->numVertices Edges
+ *   getDistanceTreesBatch (pool, graph, sources, numSources, trees);
+ *   deleteQueryPool (pool);
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "graph.h"
+
+#ifndef __Query_Pool_header
+#define __Query_Pool_header
+
+typedef struct query_pool QueryPool;
+
+/*
+ * Returns a newly created QueryPool of 'numThreads' threads, counting the
+ * calling thread, which works on every batch too.
+ * Precondition: numThreads >= 1
+ */
+QueryPool* newQueryPool(int numThreads);
+
+/*
+ * Runs Dijkstra's algorithm on Graph 'graph' from every vertex of the
+ * 'numSources' vertices in 'sources', on the threads of 'pool', and writes
+ * the distance tree from sources[i] into trees[i], an array of
+ * graph->numVertices Edges provided by the caller. The trees have the
+ * layout of getDistanceTreeDijkstra: trees[i][id] is (id -- predecessor,
+ * distance), the source gets (source -- source, 0), and vertices
+ * unreachable from the source get (id -- NOTHING, DIST_MAX). Invalid
+ * sources are skipped and their trees left untouched.
+ * Returns the number of trees written.
+ * 'graph' is only read, so any number of threads may share it, but it must
+ * not change until the batch returns. Only one batch at a time may run on
+ * 'pool'.
+ */
+int getDistanceTreesBatch(QueryPool* pool, Graph* graph, int* sources,
+                          int numSources, Edge** trees);
+
+/*
+ * Returns the number of threads of 'pool'.
+ */
+int queryPoolThreads(QueryPool* pool);
+
+/*
+ * Returns the number of queries of the last batch on 'pool' that were run
+ * by a thread other than the one whose range they started in.
+ */
+int queryPoolSteals(QueryPool* pool);
+
+/*
+ * Stops all threads of 'pool' and frees all memory allocated for it.
+ */
+void deleteQueryPool(QueryPool* pool);
+
+#endif
@@ -0,0 +1,318 @@
+/*
+ * Our vertex reordering.
+ *
+ * Every order is computed as the list order[i] of the vertex that gets new
+ * ID i; the breadth-first orders use that list as their queue. The
+ * pseudo-peripheral start vertex of reverse Cuthill-McKee is found as
+ * George and Liu do: search breadth-first from a vertex, move to a vertex
+ * of least degree in the last level, and repeat while the number of
+ * levels grows.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "graph_algos.h"
+#include "reorder.h"
+
+#define PERIPHERAL_ROUNDS 8  // most searches for a pseudo-peripheral vertex
+
+static int degreeOf(CSRGraph* csr, int v)
+{
+  return csr->offsets[v + 1] - csr->offsets[v];
+}
+
+/*
+ * Returns the order in which a breadth-first search of 'csr' visits its
+ * vertices, restarting from the lowest unvisited vertex until all are
+ * visited.
+ */
+static int* breadthFirstOrder(CSRGraph* csr)
+{
+  int n = csr->numVertices;
+  int *order = (int *) malloc (n * sizeof (int));
+  bool *visited = (bool *) calloc (n, sizeof (bool));
+  int numVisited = 0;
+
+  for (int root = 0; root < n; root++)
+  {
+    if (visited[root])
+      continue;
+    visited[root] = true;
+    order[numVisited++] = root;
+    for (int head = numVisited - 1; head < numVisited; head++)
+    {
+      int u = order[head];
+      for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+      {
+        int v = csr->targets[e];
+        if (!visited[v])
+        {
+          visited[v] = true;
+          order[numVisited++] = v;
+        }
+      }
+    }
+  }
+  free (visited);
+  return order;
+}
+
+static int compareKeys(const void* a, const void* b)
+{
+  uint64_t x = *(const uint64_t *) a;
+  uint64_t y = *(const uint64_t *) b;
+  return (x > y) - (x < y);
+}
+
+/*
+ * Sorts the 'count' vertices in 'vertices' by increasing degree in 'csr',
+ * ties by increasing ID, using 'keys' as scratch space.
+ */
+static void sortByDegree(CSRGraph* csr, int* vertices, int count,
+                         uint64_t* keys)
+{
+  for (int i = 0; i < count; i++)
+    keys[i] = (uint64_t) degreeOf (csr, vertices[i]) << 32
+              | (uint32_t) vertices[i];
+  qsort (keys, count, sizeof (uint64_t), compareKeys);
+  for (int i = 0; i < count; i++)
+    vertices[i] = (int) (uint32_t) keys[i];
+}
+
+/*
+ * Searches 'csr' breadth-first from 'start' over vertices that are not
+ * 'visited', marking them with 'stamp' in 'mark' and using 'queue'.
+ * Returns the number of levels below 'start', and sets '*candidate' to a
+ * vertex of least degree in the last level.
+ */
+static int levelSearch(CSRGraph* csr, int start, bool* visited,
+                       unsigned* mark, unsigned stamp, int* queue,
+                       int* candidate)
+{
+  int size = 0;
+  queue[size++] = start;
+  mark[start] = stamp;
+  int levelBegin = 0;
+  int depth = 0;
+  while (true)
+  {
+    int levelEnd = size;
+    for (int i = levelBegin; i < levelEnd; i++)
+      for (int e = csr->offsets[queue[i]]; e < csr->offsets[queue[i] + 1]; e++)
+      {
+        int v = csr->targets[e];
+        if (!visited[v] && mark[v] != stamp)
+        {
+          mark[v] = stamp;
+          queue[size++] = v;
+        }
+      }
+    if (size == levelEnd)
+      break;
+    levelBegin = levelEnd;
+    depth++;
+  }
+
+  *candidate = queue[levelBegin];
+  for (int i = levelBegin + 1; i < size; i++)
+    if (degreeOf (csr, queue[i]) < degreeOf (csr, *candidate))
+      *candidate = queue[i];
+  return depth;
+}
+
+/*
+ * Returns the reverse Cuthill-McKee order of 'csr', starting every
+ * component at a pseudo-peripheral vertex found from its lowest vertex.
+ */
+static int* reverseCuthillMcKeeOrder(CSRGraph* csr)
+{
+  int n = csr->numVertices;
+  int *order = (int *) malloc (n * sizeof (int));
+  int *queue = (int *) malloc (n * sizeof (int));
+  uint64_t *keys = (uint64_t *) malloc (n * sizeof (uint64_t));
+  bool *visited = (bool *) calloc (n, sizeof (bool));
+  unsigned *mark = (unsigned *) calloc (n, sizeof (unsigned));
+  unsigned stamp = 0;
+  int numVisited = 0;
+
+  for (int root = 0; root < n; root++)
+  {
+    if (visited[root])
+      continue;
+
+    int start = root;
+    int best = root;
+    int eccentricity = -1;
+    for (int round = 0; round < PERIPHERAL_ROUNDS; round++)
+    {
+      int candidate;
+      int depth = levelSearch (csr, start, visited, mark, ++stamp, queue,
+                               &candidate);
+      if (depth <= eccentricity)
+        break;
+      eccentricity = depth;
+      best = start;
+      start = candidate;
+    }
+
+    visited[best] = true;
+    order[numVisited++] = best;
+    for (int head = numVisited - 1; head < numVisited; head++)
+    {
+      int u = order[head];
+      int first = numVisited;
+      for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++)
+      {
+        int v = csr->targets[e];
+        if (!visited[v])
+        {
+          visited[v] = true;
+          order[numVisited++] = v;
+        }
+      }
+      sortByDegree (csr, order + first, numVisited - first, keys);
+    }
+  }
+
+  for (int i = 0, j = n - 1; i < j; i++, j--)
+  {
+    int swap = order[i];
+    order[i] = order[j];
+    order[j] = swap;
+  }
+  free (queue);
+  free (keys);
+  free (visited);
+  free (mark);
+  return order;
+}
+
+/*
+ * Returns the vertices of 'csr' by decreasing degree, ties by increasing
+ * ID, sorted by counting.
+ */
+static int* degreeOrder(CSRGraph* csr)
+{
+  int n = csr->numVertices;
+  int maxDegree = 0;
+  for (int v = 0; v < n; v++)
+    if (degreeOf (csr, v) > maxDegree)
+      maxDegree = degreeOf (csr, v);
+
+  /* first[d] is the first position of the vertices of degree d. */
+  int *first = (int *) calloc (maxDegree + 2, sizeof (int));
+  for (int v = 0; v < n; v++)
+    first[maxDegree - degreeOf (csr, v) + 1]++;
+  for (int d = 0; d <= maxDegree; d++)
+    first[d + 1] += first[d];
+
+  int *order = (int *) malloc (n * sizeof (int));
+  for (int v = 0; v < n; v++)
+    order[first[maxDegree - degreeOf (csr, v)]++] = v;
+  free (first);
+  return order;
+}
+
+Permutation* getVertexOrder(CSRGraph* csr, int kind)
+{
+  int *order;
+  if (kind == ORDER_BFS)
+    order = breadthFirstOrder (csr);
+  else if (kind == ORDER_RCM)
+    order = reverseCuthillMcKeeOrder (csr);
+  else if (kind == ORDER_DEGREE)
+    order = degreeOrder (csr);
+  else
+    return NULL;
+
+  int n = csr->numVertices;
+  Permutation *perm = (Permutation *) malloc (sizeof (Permutation));
+  perm->numVertices = n;
+  perm->oldId = order;
+  perm->newId = (int *) malloc (n * sizeof (int));
+  for (int i = 0; i < n; i++)
+    perm->newId[order[i]] = i;
+  return perm;
+}
+
+Graph* permuteGraph(Graph* graph, Permutation* perm)
+{
+  int n = graph->numVertices;
+  Graph *result = newArenaGraph (n, graph->numEdges);
+  for (int v = 0; v < n; v++)
+  {
+    Vertex *old = graph->vertices[perm->oldId[v]];
+    result->vertices[v] = graphNewVertex (result, v, old->value, NULL);
+
+    EdgeList **tail = &result->vertices[v]->adjList;
+    for (EdgeList *l = old->adjList; l != NULL; l = l->next)
+    {
+      Edge *edge = graphNewEdge (result, v, perm->newId[l->edge->toVertex],
+                                 l->edge->weight);
+      *tail = graphNewEdgeList (result, edge, NULL);
+      tail = &(*tail)->next;
+      result->numEdges++;
+    }
+  }
+  return result;
+}
+
+CSRGraph* permuteCSR(CSRGraph* csr, Permutation* perm)
+{
+  int n = csr->numVertices;
+  CSRGraph *result = newCSRGraph (n, csr->numEdges);
+  int next = 0;
+  for (int v = 0; v < n; v++)
+  {
+    int old = perm->oldId[v];
+    for (int e = csr->offsets[old]; e < csr->offsets[old + 1]; e++)
+    {
+      result->targets[next] = perm->newId[csr->targets[e]];
+      result->weights[next] = csr->weights[e];
+      next++;
+    }
+    result->offsets[v + 1] = next;
+  }
+  return result;
+}
+
+void restoreEdges(Edge* edges, int numEdges, Permutation* perm)
+{
+  for (int i = 0; i < numEdges; i++)
+  {
+    if (edges[i].fromVertex != NOTHING)
+      edges[i].fromVertex = perm->oldId[edges[i].fromVertex];
+    if (edges[i].toVertex != NOTHING)
+      edges[i].toVertex = perm->oldId[edges[i].toVertex];
+  }
+}
+
+Edge* restoreDistanceTree(Edge* tree, Permutation* perm)
+{
+  int n = perm->numVertices;
+  Edge *result = (Edge *) malloc (n * sizeof (Edge));
+  for (int v = 0; v < n; v++)
+    result[perm->oldId[v]] = tree[v];
+  restoreEdges (result, n, perm);
+  return result;
+}
+
+void* permuteArray(const void* values, size_t itemSize, Permutation* perm)
+{
+  int n = perm->numVertices;
+  char *result = (char *) malloc (n * itemSize);
+  for (int v = 0; v < n; v++)
+    memcpy (result + perm->newId[v] * itemSize,
+            (const char *) values + v * itemSize, itemSize);
+  return result;
+}
+
+void deletePermutation(Permutation* perm)
+{
+  if (perm == NULL)
+    return;
+  free (perm->newId);
+  free (perm->oldId);
+  free (perm);
+}
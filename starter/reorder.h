@@ -0,0 +1,98 @@
+/*
+ * Header file for our vertex reordering.
+ *
+ * Vertex IDs come straight from the input file, so the neighbours of a
+ * vertex are often far apart in graph->vertices and in the per-vertex
+ * arrays of the algorithms (distances, predecessors, the heap's indexMap),
+ * and every relaxation misses the cache. Renumbering the vertices so that
+ * neighbours get nearby IDs fixes that:
+ *   ORDER_BFS     breadth-first order, restarting from the lowest
+ *                 unvisited vertex
+ *   ORDER_RCM     reverse Cuthill-McKee: breadth-first from a
+ *                 pseudo-peripheral vertex of every component, visiting
+ *                 the neighbours of a vertex by increasing degree, then
+ *                 reversed; keeps the bandwidth of the adjacency matrix
+ *                 small
+ *   ORDER_DEGREE  by decreasing degree, so that hubs share cache lines
+ *
+ * The algorithms run on the permuted graph unchanged; a Permutation maps
+ * IDs both ways, so their results can be reported in the original IDs.
+ *
+ *   Permutation *perm = getVertexOrder (csr, ORDER_RCM);
+ *   Graph *local = permuteGraph (graph, perm);
+ *   Edge *tree = getDistanceTreeDijkstra (local, perm->newId[source]);
+ *   Edge *original = restoreDistanceTree (tree, perm);
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "csr.h"
+#include "graph.h"
+
+#ifndef __Reorder_header
+#define __Reorder_header
+
+/* Orders getVertexOrder can compute. */
+#define ORDER_BFS 0
+#define ORDER_RCM 1
+#define ORDER_DEGREE 2
+
+typedef struct permutation {
+  int numVertices;  // vertex IDs are 0, 1, ..., numVertices-1 in both
+                    //   numberings
+  int* newId;       // newId[v] is the new ID of original vertex v
+  int* oldId;       // oldId[v] is the original ID of new vertex v
+} Permutation;
+
+/*
+ * Returns a newly created Permutation that renumbers the vertices of 'csr'
+ * in the order 'kind' (ORDER_BFS, ORDER_RCM or ORDER_DEGREE), or NULL if
+ * 'kind' is not one of them. The orders only follow edges in their
+ * direction, so for directed graphs they work best on the CSR of the
+ * graph with its reverse edges added.
+ */
+Permutation* getVertexOrder(CSRGraph* csr, int kind);
+
+/*
+ * Returns a newly created arena-backed Graph in which original vertex v of
+ * 'graph' is vertex perm->newId[v], with the same value, and the edges of
+ * every vertex keep the order of its adjacency list.
+ * Precondition: 'perm' was made for a graph of graph->numVertices vertices
+ */
+Graph* permuteGraph(Graph* graph, Permutation* perm);
+
+/*
+ * Same as permuteGraph, for the CSR graph 'csr'.
+ */
+CSRGraph* permuteCSR(CSRGraph* csr, Permutation* perm);
+
+/*
+ * Maps the endpoints of the 'numEdges' edges in 'edges', such as the MST
+ * of getMSTprim on a permuted graph, back to original IDs in place.
+ * Endpoints that are NOTHING stay NOTHING.
+ */
+void restoreEdges(Edge* edges, int numEdges, Permutation* perm);
+
+/*
+ * Returns a newly created distance tree in original IDs for the distance
+ * tree 'tree' computed on a permuted graph: result[v] is the tree edge of
+ * original vertex v, with both endpoints mapped back to original IDs.
+ */
+Edge* restoreDistanceTree(Edge* tree, Permutation* perm);
+
+/*
+ * Returns a newly created copy of the per-vertex array 'values' of
+ * perm->numVertices items of 'itemSize' bytes, indexed by new IDs instead
+ * of original ones: item perm->newId[v] of the copy is item v of 'values'.
+ */
+void* permuteArray(const void* values, size_t itemSize, Permutation* perm);
+
+/*
+ * Frees all memory allocated for 'perm'.
+ */
+void deletePermutation(Permutation* perm);
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Our thread team implementation.
+ */
+
+#include "thread_team.h"
+
+typedef struct worker_args {
+  ThreadTeam* team;
+  int thread;
+} WorkerArgs;
+
+/*
+ * Body of every worker thread: waits for a new generation of work, runs the
+ * task, and reports back, until the team shuts down.
+ */
+static void* workerMain(void* p)
+{
+  WorkerArgs args = *(WorkerArgs *) p;
+  free (p);
+  ThreadTeam *team = args.team;
+  unsigned seen = 0;
+
+  pthread_mutex_lock (&team->lock);
+  while (true)
+  {
+    while (!team->shutdown && team->generation == seen)
+      pthread_cond_wait (&team->wakeUp, &team->lock);
+    if (team->shutdown)
+      break;
+    seen = team->generation;
+    TeamTask task = team->task;
+    void *arg = team->arg;
+    pthread_mutex_unlock (&team->lock);
+
+    task (arg, args.thread, team->numThreads);
+
+    pthread_mutex_lock (&team->lock);
+    if (--team->running == 0)
+      pthread_cond_signal (&team->allDone);
+  }
+  pthread_mutex_unlock (&team->lock);
+  return NULL;
+}
+
+ThreadTeam* newThreadTeam(int numThreads)
+{
+  ThreadTeam *team = (ThreadTeam *) malloc (sizeof (ThreadTeam));
+  team->numThreads = numThreads < 1 ? 1 : numThreads;
+  team->workers = (pthread_t *) malloc (team->numThreads * sizeof (pthread_t));
+  pthread_mutex_init (&team->lock, NULL);
+  pthread_cond_init (&team->wakeUp, NULL);
+  pthread_cond_init (&team->allDone, NULL);
+  team->generation = 0;
+  team->running = 0;
+  team->shutdown = false;
+  team->task = NULL;
+  team->arg = NULL;
+
+  for (int t = 1; t < team->numThreads; t++)
+  {
+    WorkerArgs *args = (WorkerArgs *) malloc (sizeof (WorkerArgs));
+    args->team = team;
+    args->thread = t;
+    pthread_create (&team->workers[t], NULL, workerMain, args);
+  }
+  return team;
+}
+
+void teamRun(ThreadTeam* team, TeamTask task, void* arg)
+{
+  if (team->numThreads > 1)
+  {
+    pthread_mutex_lock (&team->lock);
+    team->task = task;
+    team->arg = arg;
+    team->running = team->numThreads - 1;
+    team->generation++;
+    pthread_cond_broadcast (&team->wakeUp);
+    pthread_mutex_unlock (&team->lock);
+  }
+
+  task (arg, 0, team->numThreads);
+
+  if (team->numThreads > 1)
+  {
+    pthread_mutex_lock (&team->lock);
+    while (team->running > 0)
+      pthread_cond_wait (&team->allDone, &team->lock);
+    pthread_mutex_unlock (&team->lock);
+  }
+}
+
+void teamSlice(int n, int thread, int numThreads, int* begin, int* end)
+{
+  *begin = (int) ((long long) n * thread / numThreads);
+  *end = (int) ((long long) n * (thread + 1) / numThreads);
+}
+
+void deleteThreadTeam(ThreadTeam* team)
+{
+  pthread_mutex_lock (&team->lock);
+  team->shutdown = true;
+  pthread_cond_broadcast (&team->wakeUp);
+  pthread_mutex_unlock (&team->lock);
+
+  for (int t = 1; t < team->numThreads; t++)
+    pthread_join (team->workers[t], NULL);
+
+  pthread_mutex_destroy (&team->lock);
+  pthread_cond_destroy (&team->wakeUp);
+  pthread_cond_destroy (&team->allDone);
+  free (team->workers);
+  free (team);
+}
@@ -0,0 +1,57 @@
+/*
+ * Header file for our thread team: a fixed set of threads that repeatedly
+ * run the same task in lock step (fork/join), for data-parallel phases.
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef __ThreadTeam_header
+#define __ThreadTeam_header
+
+/*
+ * A task run by every thread of a team. 'thread' is the index of the calling
+ * thread (0 .. numThreads-1) and 'arg' is shared by all of them.
+ */
+typedef void (*TeamTask)(void* arg, int thread, int numThreads);
+
+typedef struct thread_team {
+  int numThreads;         // total number of threads, including the caller
+  pthread_t* workers;     // the numThreads-1 threads started by the team
+  pthread_mutex_t lock;   // protects all fields below
+  pthread_cond_t wakeUp;  // signalled when a task is posted or on shutdown
+  pthread_cond_t allDone; // signalled when the last worker finishes a task
+  unsigned generation;    // number of tasks posted so far
+  int running;            // number of workers still running the task
+  bool shutdown;          // true once the team is being deleted
+  TeamTask task;          // the current task
+  void* arg;              // the argument of the current task
+} ThreadTeam;
+
+/*
+ * Returns a newly created team of 'numThreads' threads. The calling thread
+ * counts as thread 0, so numThreads-1 threads are started.
+ * Precondition: numThreads >= 1
+ */
+ThreadTeam* newThreadTeam(int numThreads);
+
+/*
+ * Runs 'task' with argument 'arg' on every thread of 'team', including the
+ * calling thread as thread 0, and returns once all of them have finished.
+ */
+void teamRun(ThreadTeam* team, TeamTask task, void* arg);
+
+/*
+ * Sets ['begin', 'end') to the share of thread 'thread' out of 'numThreads'
+ * when 'n' items are split into contiguous, nearly equal ranges.
+ */
+void teamSlice(int n, int thread, int numThreads, int* begin, int* end);
+
+/*
+ * Stops all threads of 'team' and frees all memory allocated for it.
+ */
+void deleteThreadTeam(ThreadTeam* team);
+
+#endif
@@ -0,0 +1,205 @@
+/*
+ * Our cache of distance trees.
+ *
+ * The entries in use are kept at the front of cache->entries, and
+ * cache->entryOf maps a source to its entry, so a hit takes O(1) time.
+ * A miss evicts by scanning all entries for the one the policy ranks
+ * lowest; that costs O(capacity), which is small next to the Dijkstra run
+ * every miss pays for anyway. The tree arrays are allocated on first use
+ * and then handed from evicted entries to new ones, never freed.
+ */
+
+#include "graph_algos.h"
+#include "path_view.h"
+#include "tree_cache.h"
+
+/*
+ * Sizes 'cache' for the current number of vertices of its graph, and
+ * empties it.
+ */
+static void sizeTreeCache(TreeCache* cache)
+{
+  int n = cache->graph->numVertices;
+  size_t treeBytes = (n > 0 ? n : 1) * sizeof (Edge);
+  size_t fit = cache->budget / treeBytes;
+  if (fit > (size_t) n)
+    fit = n;   // there are no more trees than vertices
+  cache->capacity = fit < 1 ? 1 : (int) fit;
+  cache->numEntries = 0;
+  cache->entries = (CacheEntry *) malloc (cache->capacity
+                                          * sizeof (CacheEntry));
+  for (int k = 0; k < cache->capacity; k++)
+  {
+    cache->entries[k].source = NOTHING;
+    cache->entries[k].tree = NULL;
+  }
+  cache->entryOf = (int *) malloc (n * sizeof (int));
+  for (int v = 0; v < n; v++)
+    cache->entryOf[v] = NOTHING;
+  cache->ws = newWorkspace (n);
+}
+
+/*
+ * Frees the entries, trees and workspace of 'cache'.
+ */
+static void freeTreeCache(TreeCache* cache)
+{
+  for (int k = 0; k < cache->capacity; k++)
+    free (cache->entries[k].tree);
+  free (cache->entries);
+  free (cache->entryOf);
+  deleteWorkspace (cache->ws);
+}
+
+TreeCache* newTreeCache(Graph* graph, size_t budget, int policy)
+{
+  TreeCache *cache = (TreeCache *) malloc (sizeof (TreeCache));
+  cache->graph = graph;
+  cache->policy = policy == CACHE_LFU ? CACHE_LFU : CACHE_LRU;
+  cache->budget = budget;
+  cache->clock = 0;
+  cache->hits = 0;
+  cache->misses = 0;
+  cache->evictions = 0;
+  cache->invalidations = 0;
+  sizeTreeCache (cache);
+  return cache;
+}
+
+/*
+ * Returns true iff the policy of 'cache' would rather evict entry 'a' than
+ * entry 'b'.
+ */
+static bool evictsBefore(TreeCache* cache, CacheEntry* a, CacheEntry* b)
+{
+  if (cache->policy == CACHE_LFU && a->uses != b->uses)
+    return a->uses < b->uses;
+  return a->lastUse < b->lastUse;
+}
+
+/*
+ * Removes entry 'k' from the entries in use by moving the last entry in use
+ * into its place. Its tree array moves to the freed slot, to be reused.
+ */
+static void removeEntry(TreeCache* cache, int k)
+{
+  CacheEntry removed = cache->entries[k];
+  int last = --cache->numEntries;
+  cache->entryOf[removed.source] = NOTHING;
+  if (k != last)
+  {
+    cache->entries[k] = cache->entries[last];
+    cache->entryOf[cache->entries[k].source] = k;
+  }
+  cache->entries[last] = removed;
+  cache->entries[last].source = NOTHING;
+}
+
+Edge* getCachedTree(TreeCache* cache, int source)
+{
+  Graph *graph = cache->graph;
+  if (source < 0 || source >= graph->numVertices)
+    return NULL;
+
+  cache->clock++;
+  int k = cache->entryOf[source];
+  if (k != NOTHING)
+  {
+    cache->hits++;
+  }
+  else
+  {
+    cache->misses++;
+    if (cache->numEntries == cache->capacity)
+    {
+      int victim = 0;
+      for (int i = 1; i < cache->numEntries; i++)
+        if (evictsBefore (cache, &cache->entries[i],
+                          &cache->entries[victim]))
+          victim = i;
+      removeEntry (cache, victim);
+      cache->evictions++;
+    }
+
+    k = cache->numEntries++;
+    CacheEntry *entry = &cache->entries[k];
+    if (entry->tree == NULL)
+      entry->tree = (Edge *) malloc (graph->numVertices * sizeof (Edge));
+    fillDistanceTreeWS (cache->ws, graph, source, entry->tree);
+    entry->source = source;
+    entry->uses = 0;
+    cache->entryOf[source] = k;
+  }
+
+  CacheEntry *entry = &cache->entries[k];
+  entry->uses++;
+  entry->lastUse = cache->clock;
+  return entry->tree;
+}
+
+dist_t getCachedDistance(TreeCache* cache, int source, int target)
+{
+  if (target < 0 || target >= cache->graph->numVertices)
+    return NOTHING;
+  Edge *tree = getCachedTree (cache, source);
+  if (tree == NULL || tree[target].weight == DIST_MAX)
+    return NOTHING;
+  return tree[target].weight;
+}
+
+EdgeList* getCachedPath(TreeCache* cache, int source, int vertex)
+{
+  if (vertex < 0 || vertex >= cache->graph->numVertices)
+    return NULL;
+  Edge *tree = getCachedTree (cache, source);
+  if (tree == NULL)
+    return NULL;
+  return pathToEdgeList (tree, source, vertex);
+}
+
+void invalidateCachedTree(TreeCache* cache, int source)
+{
+  if (source < 0 || source >= cache->graph->numVertices
+      || cache->entryOf[source] == NOTHING)
+    return;
+  removeEntry (cache, cache->entryOf[source]);
+  cache->invalidations++;
+}
+
+void invalidateTreeCache(TreeCache* cache)
+{
+  cache->invalidations += cache->numEntries;
+  if (cache->ws->numVertices != cache->graph->numVertices)
+  {
+    freeTreeCache (cache);
+    sizeTreeCache (cache);
+    return;
+  }
+
+  for (int k = 0; k < cache->numEntries; k++)
+  {
+    cache->entryOf[cache->entries[k].source] = NOTHING;
+    cache->entries[k].source = NOTHING;
+  }
+  cache->numEntries = 0;
+}
+
+void printTreeCacheStats(TreeCache* cache)
+{
+  long long lookups = cache->hits + cache->misses;
+  printf ("trees cached:          %d of %d (%zu bytes each)\n",
+          cache->numEntries, cache->capacity,
+          cache->graph->numVertices * sizeof (Edge));
+  printf ("hits / misses:         %lld / %lld (%.1f%% hits)\n", cache->hits,
+          cache->misses, lookups ? 100.0 * cache->hits / lookups : 0.0);
+  printf ("evictions:             %lld\n", cache->evictions);
+  printf ("invalidations:         %lld\n", cache->invalidations);
+}
+
+void deleteTreeCache(TreeCache* cache)
+{
+  if (cache == NULL)
+    return;
+  freeTreeCache (cache);
+  free (cache);
+}
@@ -0,0 +1,114 @@
+/*
+ * Header file for our cache of distance trees.
+ *
+ * A TreeCache keeps the distance trees of the most useful start vertices of
+ * a Graph, within a memory budget, so that repeated queries from the same
+ * source read the tree instead of rerunning Dijkstra's algorithm. When a
+ * new tree does not fit, the least recently used tree (CACHE_LRU) or the
+ * least often used one (CACHE_LFU) is evicted, and its memory reused for
+ * the new tree. The cache cannot see changes to the graph: whoever changes
+ * it must call invalidateTreeCache.
+ *
+ *   TreeCache *cache = newTreeCache (graph, 64 << 20, CACHE_LRU);
+ *   EdgeList *path = getCachedPath (cache, 0, 42);   // computes the tree
+ *   deleteEdgeList (path);
+ *   path = getCachedPath (cache, 0, 7);              // reuses it
+ *   deleteEdgeList (path);
+ *   deleteTreeCache (cache);
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "graph.h"
+#include "workspace.h"
+
+#ifndef __Tree_Cache_header
+#define __Tree_Cache_header
+
+/* Eviction policies of a TreeCache. */
+#define CACHE_LRU 0  // evict the tree that was looked up least recently
+#define CACHE_LFU 1  // evict the tree with the fewest lookups; ties go to
+                     //   the least recently used one
+
+typedef struct cache_entry {
+  int source;         // start vertex of 'tree', or NOTHING if unused
+  Edge* tree;         // distance tree from 'source': numVertices Edges
+  long long uses;     // lookups of 'tree' since it was computed
+  long long lastUse;  // the cache's clock at the last lookup of 'tree'
+} CacheEntry;
+
+typedef struct tree_cache {
+  Graph* graph;          // the graph the trees belong to
+  int policy;            // CACHE_LRU or CACHE_LFU
+  size_t budget;         // bytes the trees may take
+  int capacity;          // trees that fit in 'budget', but at least 1
+  int numEntries;        // entries in use; entries[0 .. numEntries-1]
+  CacheEntry* entries;   // 'capacity' entries
+  int* entryOf;          // entryOf[v] is the index of the entry holding
+                         //   the tree from v, or NOTHING
+  Workspace* ws;         // state of the searches run on a miss
+  long long clock;       // number of lookups so far
+  long long hits;        // lookups served from a cached tree
+  long long misses;      // lookups that ran Dijkstra's algorithm
+  long long evictions;   // trees dropped to make room for another
+  long long invalidations;  // trees dropped by invalidation
+} TreeCache;
+
+/*
+ * Returns a newly created, empty TreeCache for Graph 'graph' whose trees
+ * may take up to 'budget' bytes, evicting by 'policy' (CACHE_LRU or
+ * CACHE_LFU). A tree takes graph->numVertices * sizeof (Edge) bytes; if
+ * not even one fits, one is kept anyway.
+ */
+TreeCache* newTreeCache(Graph* graph, size_t budget, int policy);
+
+/*
+ * Returns the distance tree from 'source', in the layout of
+ * getDistanceTreeDijkstra, computing and caching it on a miss. The tree
+ * belongs to 'cache'; it stays valid until the next call of any function
+ * on 'cache'. Returns NULL if 'source' is not valid in the graph.
+ */
+Edge* getCachedTree(TreeCache* cache, int source);
+
+/*
+ * Returns distance(source, target), or NOTHING if 'target' is unreachable
+ * from 'source' or either vertex is not valid. Looks the distance up in
+ * the cached tree from 'source', computing it on a miss.
+ */
+dist_t getCachedDistance(TreeCache* cache, int source, int target);
+
+/*
+ * Returns the path from 'vertex' to 'source' as a newly created list of
+ * edges, the same list getShortestPaths stores for 'vertex' in the tree
+ * from 'source', read from the cached tree (computed on a miss). The list
+ * is NULL if vertex == source, 'vertex' is unreachable, or either vertex
+ * is not valid; the caller frees it with deleteEdgeList.
+ */
+EdgeList* getCachedPath(TreeCache* cache, int source, int vertex);
+
+/*
+ * Drops the cached tree from 'source', if any. Call it if only trees from
+ * some sources went out of date.
+ */
+void invalidateCachedTree(TreeCache* cache, int source);
+
+/*
+ * Drops all cached trees. Call it whenever the graph changes. If the graph
+ * has a different number of vertices now, the cache is resized to it.
+ */
+void invalidateTreeCache(TreeCache* cache);
+
+/*
+ * Prints the size, hit rate and counters of 'cache'.
+ */
+void printTreeCacheStats(TreeCache* cache);
+
+/*
+ * Frees all memory allocated for 'cache', but not its graph.
+ */
+void deleteTreeCache(TreeCache* cache);
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Our reusable algorithm workspace.
+ */
+
+#include <string.h>
+
+#include "workspace.h"
+
+Workspace* newWorkspace(int numVertices)
+{
+  Workspace *ws = (Workspace *) malloc (sizeof (Workspace));
+  ws->numVertices = numVertices;
+  ws->epoch = 1;
+  ws->reached = (unsigned *) calloc (numVertices, sizeof (unsigned));
+  ws->settled = (unsigned *) calloc (numVertices, sizeof (unsigned));
+  ws->distances = (dist_t *) malloc (numVertices * sizeof (dist_t));
+  ws->predecessors = (int *) malloc (numVertices * sizeof (int));
+  ws->heap = newHeap (numVertices);
+  ws->touched = (int *) malloc (numVertices * sizeof (int));
+  ws->numTouched = 0;
+  return ws;
+}
+
+void resetWorkspace(Workspace* ws)
+{
+  ws->epoch++;
+  if (ws->epoch == 0)
+  {
+    /* The stamps wrapped around: old stamps could collide, clear them. */
+    memset (ws->reached, 0, ws->numVertices * sizeof (unsigned));
+    memset (ws->settled, 0, ws->numVertices * sizeof (unsigned));
+    ws->epoch = 1;
+  }
+  ws->heap->size = 0;
+  ws->numTouched = 0;
+}
+
+bool wsRelax(Workspace* ws, int id, dist_t distance, int predecessor)
+{
+  return wsRelaxWithKey (ws, id, distance, distance, predecessor);
+}
+
+bool wsRelaxWithKey(Workspace* ws, int id, dist_t distance, dist_t key,
+                    int predecessor)
+{
+  /* A saturated distance (see distAdd) leaves 'id' unreached. */
+  if (ws->settled[id] == ws->epoch || distance == DIST_MAX)
+    return false;
+
+  if (ws->reached[id] != ws->epoch)
+  {
+    ws->reached[id] = ws->epoch;
+    ws->touched[ws->numTouched++] = id;
+    insert (ws->heap, key, id);
+  }
+  else if (distance >= ws->distances[id])
+    return false;
+  else
+    decreasePriority (ws->heap, id, key);
+
+  ws->distances[id] = distance;
+  ws->predecessors[id] = predecessor;
+  return true;
+}
+
+HeapNode wsSettleNext(Workspace* ws)
+{
+  HeapNode u = extractMin (ws->heap);
+  ws->settled[u.id] = ws->epoch;
+  return u;
+}
+
+bool wsReached(Workspace* ws, int id)
+{
+  return ws->reached[id] == ws->epoch;
+}
+
+bool wsSettled(Workspace* ws, int id)
+{
+  return ws->settled[id] == ws->epoch;
+}
+
+dist_t wsDistance(Workspace* ws, int id)
+{
+  return wsReached (ws, id) ? ws->distances[id] : DIST_MAX;
+}
+
+int wsPredecessor(Workspace* ws, int id)
+{
+  return wsReached (ws, id) ? ws->predecessors[id] : NOTHING;
+}
+
+EdgeList* wsPathTo(Workspace* ws, int vertex)
+{
+  EdgeList *path = NULL;
+  for (int v = vertex; ws->predecessors[v] != NOTHING; v = ws->predecessors[v])
+  {
+    int u = ws->predecessors[v];
+    path = newEdgeList (newEdge (u, v, ws->distances[v] - ws->distances[u]),
+                        path);
+  }
+  return path;
+}
+
+void deleteWorkspace(Workspace* ws)
+{
+  free (ws->reached);
+  free (ws->settled);
+  free (ws->distances);
+  free (ws->predecessors);
+  deleteHeap (ws->heap);
+  free (ws->touched);
+  free (ws);
+}
@@ -0,0 +1,109 @@
+/*
+ * Header file for our reusable algorithm workspace.
+ *
+ * A Workspace holds the per-vertex state of Prim's and Dijkstra's algorithms
+ * (tentative distances, predecessors, finished flags and the priority queue)
+ * so that it can be reused across queries on graphs with the same number of
+ * vertices. Instead of reinitialising O(n) arrays, every entry is stamped
+ * with the epoch of the query that wrote it; starting a new query only bumps
+ * the epoch, so a query pays only for the vertices it actually reaches.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "graph.h"
+#include "minheap.h"
+
+#ifndef __Workspace_header
+#define __Workspace_header
+
+typedef struct workspace {
+  int numVertices;      // vertex IDs are 0, 1, ..., numVertices-1
+  unsigned epoch;       // stamp of the current query; never 0
+  unsigned* reached;    // reached[id] == epoch iff vertex id has a tentative
+                        //   distance in the current query
+  unsigned* settled;    // settled[id] == epoch iff vertex id is finished
+                        //   in the current query
+  dist_t* distances;    // distances[id]; valid iff id is reached
+  int* predecessors;    // predecessors[id]; valid iff id is reached
+  MinHeap* heap;        // reached vertices that are not settled yet
+  int* touched;         // the vertices reached in the current query, in the
+                        //   order they were reached
+  int numTouched;       // number of entries in 'touched'
+} Workspace;
+
+/*
+ * Returns a newly created Workspace for graphs with 'numVertices' vertices.
+ * Precondition: numVertices >= 0
+ */
+Workspace* newWorkspace(int numVertices);
+
+/*
+ * Starts a new query in 'ws': afterwards no vertex is reached or settled and
+ * the priority queue is empty. Takes O(1) time, except once every 2^32-1
+ * queries when all stamps are cleared.
+ */
+void resetWorkspace(Workspace* ws);
+
+/*
+ * Gives vertex 'id' the tentative distance 'distance' via 'predecessor' and
+ * returns true, if 'id' is not settled and either is not reached yet or has
+ * a larger tentative distance. Has no effect and returns false, otherwise,
+ * and also if 'distance' is DIST_MAX.
+ */
+bool wsRelax(Workspace* ws, int id, dist_t distance, int predecessor);
+
+/*
+ * Same as wsRelax, but orders vertex 'id' in the priority queue by 'key'
+ * instead of by 'distance', as A* search does. 'key' - 'distance' must be
+ * the same in every call for 'id' within one query.
+ */
+bool wsRelaxWithKey(Workspace* ws, int id, dist_t distance, dist_t key,
+                    int predecessor);
+
+/*
+ * Removes the reached vertex with the smallest tentative distance from the
+ * priority queue of 'ws', marks it settled, and returns it.
+ * Precondition: the priority queue of 'ws' is non-empty
+ */
+HeapNode wsSettleNext(Workspace* ws);
+
+/*
+ * Returns true iff vertex 'id' is reached in the current query of 'ws'.
+ */
+bool wsReached(Workspace* ws, int id);
+
+/*
+ * Returns true iff vertex 'id' is settled in the current query of 'ws'.
+ */
+bool wsSettled(Workspace* ws, int id);
+
+/*
+ * Returns the tentative distance of vertex 'id' in the current query of
+ * 'ws', or DIST_MAX if 'id' is not reached.
+ */
+dist_t wsDistance(Workspace* ws, int id);
+
+/*
+ * Returns the predecessor of vertex 'id' in the current query of 'ws', or
+ * NOTHING if 'id' is not reached or has no predecessor.
+ */
+int wsPredecessor(Workspace* ws, int id);
+
+/*
+ * Returns the path from the source of the current query to 'vertex' along
+ * the predecessors in 'ws', as a newly created list of edges
+ *   [(source -- id_1, w_1), (id_1 -- id_2, w_2), ..., (id_n -- vertex, w_n)]
+ * Returns NULL if 'vertex' is the source.
+ * Precondition: 'vertex' is reached in 'ws'
+ */
+EdgeList* wsPathTo(Workspace* ws, int vertex);
+
+/*
+ * Frees all memory allocated for 'ws'.
+ */
+void deleteWorkspace(Workspace* ws);
+
+#endif